@@ -0,0 +1,68 @@
+// Global operator new/delete replacements that count heap allocations, so
+// every benchmark row can report allocations per operation.
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#if defined(_WIN32)
+  #include <malloc.h>
+#endif
+#include "harness.hpp"
+
+namespace {
+std::atomic<std::uint64_t> g_count{0};
+std::atomic<std::uint64_t> g_bytes{0};
+
+void count(std::size_t n) {
+  g_count.fetch_add(1, std::memory_order_relaxed);
+  g_bytes.fetch_add(n, std::memory_order_relaxed);
+}
+
+void* counted_alloc(std::size_t n) {
+  count(n);
+  void* p = std::malloc(n ? n : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void* counted_aligned_alloc(std::size_t n, std::align_val_t al) {
+  count(n);
+  const auto align = (std::size_t)al;
+#if defined(_WIN32)
+  void* p = _aligned_malloc(n ? n : 1, align);
+#else
+  void* p = std::aligned_alloc(align, ((n ? n : 1) + align - 1) / align * align);
+#endif
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void aligned_free(void* p) noexcept {
+#if defined(_WIN32)
+  _aligned_free(p);
+#else
+  std::free(p);
+#endif
+}
+} // namespace
+
+namespace pulseui::bench {
+alloc_totals allocations() {
+  return alloc_totals{g_count.load(std::memory_order_relaxed), g_bytes.load(std::memory_order_relaxed)};
+}
+} // namespace pulseui::bench
+
+void* operator new(std::size_t n) { return counted_alloc(n); }
+void* operator new[](std::size_t n) { return counted_alloc(n); }
+void* operator new(std::size_t n, std::align_val_t a) { return counted_aligned_alloc(n, a); }
+void* operator new[](std::size_t n, std::align_val_t a) { return counted_aligned_alloc(n, a); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { aligned_free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { aligned_free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { aligned_free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { aligned_free(p); }
@@ -0,0 +1,355 @@
+// Executor, store, timer and reactive-operator benchmarks.
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <pulse/pulse.hpp>
+#include <pulseui/core/loop_executor.hpp>
+#include <pulseui/core/reactive.hpp>
+#include <pulseui/core/store.hpp>
+#include <pulseui/core/timer_service.hpp>
+#include "harness.hpp"
+
+using namespace pulseui;
+using namespace pulseui::bench;
+
+namespace {
+
+struct Blob {
+  std::vector<std::uint8_t> data;
+  std::uint64_t counter{};
+  bool operator==(const Blob& o) const { return counter == o.counter && data == o.data; }
+};
+
+struct Bump { std::uint64_t by; };
+
+// Topic -> executor -> subscriber: the pipeline every store sits behind.
+template <class Action>
+struct pipeline {
+  core::loop_executor ex;
+  core::pulse_executor_adapter pex{ex};
+  pulse::topic<Action> in;
+  pulse::observable<Action> source() { return pulse::as_observable(in, pex); }
+};
+
+} // namespace
+
+// Producers flood one loop_executor drained by this thread; ns/op is the
+// wall time per task over all producers.
+PULSEUI_BENCH(executor_post) {
+  const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned producers : {1u, 2u, 4u, 8u}) {
+    if (producers > 1 && producers > hw) break;
+    constexpr std::uint64_t kPerProducer = 50'000;
+    const std::uint64_t total = kPerProducer * producers;
+    s.run_once("executor.post/producers=" + std::to_string(producers), total, [&] {
+      core::loop_executor ex;
+      std::atomic<bool> go{false};
+      std::uint64_t done = 0;
+      std::vector<std::thread> threads;
+      for (unsigned p = 0; p < producers; ++p) {
+        threads.emplace_back([&] {
+          while (!go.load(std::memory_order_acquire)) {}
+          for (std::uint64_t i = 0; i < kPerProducer; ++i) ex.post([&done] { ++done; });
+        });
+      }
+      go.store(true, std::memory_order_release);
+      while (done < total) {
+        if (ex.run_pending() == 0) ex.wait_for(std::chrono::microseconds(100));
+      }
+      for (auto& t : threads) t.join();
+    });
+  }
+}
+
+// Post -> run latency with one task in flight per producer, so it measures
+// the wake-up path rather than queue depth.
+PULSEUI_BENCH(executor_latency) {
+  const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned producers : {1u, 4u}) {
+    if (producers > 1 && producers > hw) break;
+    constexpr std::uint64_t kPerProducer = 2'000;
+    const std::uint64_t total = kPerProducer * producers;
+    std::vector<std::uint64_t> latencies;
+    latencies.reserve(total);
+    auto& r = s.run_once("executor.latency/producers=" + std::to_string(producers), total, [&] {
+      latencies.clear();
+      core::loop_executor ex;
+      std::atomic<std::uint64_t> done{0};
+      std::vector<std::thread> threads;
+      for (unsigned p = 0; p < producers; ++p) {
+        threads.emplace_back([&] {
+          std::atomic<bool> ran{false};
+          for (std::uint64_t i = 0; i < kPerProducer; ++i) {
+            ran.store(false, std::memory_order_relaxed);
+            const std::uint64_t t = now_ns();
+            ex.post([&latencies, &done, &ran, t] {
+              latencies.push_back(now_ns() - t);
+              done.fetch_add(1, std::memory_order_relaxed);
+              ran.store(true, std::memory_order_release);
+            });
+            while (!ran.load(std::memory_order_acquire)) std::this_thread::yield();
+          }
+        });
+      }
+      while (done.load(std::memory_order_relaxed) < total) {
+        if (ex.run_pending() == 0) ex.wait_for(std::chrono::milliseconds(1));
+      }
+      for (auto& t : threads) t.join();
+    });
+    latency_percentiles(latencies, r);
+  }
+}
+
+// post + run on the same thread, in batches of 256.
+PULSEUI_BENCH(executor_post_local) {
+  core::loop_executor ex;
+  std::uint64_t n = 0;
+  s.run("executor.post_run/local", 256, [&] {
+    for (int i = 0; i < 256; ++i) ex.post([&n] { ++n; });
+    ex.run_pending();
+  });
+  keep(n);
+}
+
+// --check: 8 producers post 20k tasks each while this thread drains. Every
+// task must run exactly once, and each producer's tasks in posting order.
+// Every 8th task has a capture too big for the task's inline buffer, so the
+// pooled blocks are freed on this thread and reused by the producers.
+PULSEUI_BENCH(check_executor_mpsc) {
+  constexpr unsigned kProducers = 8;
+  constexpr std::uint64_t kPerProducer = 20'000;
+  constexpr std::uint64_t kTotal = kProducers * kPerProducer;
+  std::vector<std::uint64_t> next(kProducers);
+  std::uint64_t ran = 0, out_of_order = 0;
+  s.run_once("executor.mpsc_stress/producers=8", kTotal, [&] {
+    core::loop_executor ex;
+    std::fill(next.begin(), next.end(), 0);
+    ran = out_of_order = 0;
+    auto record = [&](unsigned p, std::uint64_t seq) {
+      if (seq != next[p]) ++out_of_order;
+      next[p] = seq + 1;
+      ++ran;
+    };
+    std::atomic<unsigned> finished{0};
+    std::vector<std::thread> threads;
+    for (unsigned p = 0; p < kProducers; ++p) {
+      threads.emplace_back([&, p] {
+        for (std::uint64_t i = 0; i < kPerProducer; ++i) {
+          if (i % 8 == 7) {
+            std::array<std::uint64_t, 12> pad{};
+            pad[0] = i;
+            ex.post([&record, p, pad] { record(p, pad[0]); });
+          } else {
+            ex.post([&record, p, i] { record(p, i); });
+          }
+        }
+        finished.fetch_add(1, std::memory_order_release);
+      });
+    }
+    while (finished.load(std::memory_order_acquire) < kProducers) {
+      if (ex.run_pending() == 0) ex.wait_for(std::chrono::microseconds(100));
+    }
+    for (auto& t : threads) t.join();
+    ex.run_pending();
+    s.expect(ran == kTotal, "executor.mpsc_stress: " + std::to_string(ran) + " of " +
+                              std::to_string(kTotal) + " tasks ran");
+    s.expect(out_of_order == 0, "executor.mpsc_stress: " + std::to_string(out_of_order) +
+                                  " tasks ran out of their producer's order");
+  });
+}
+
+// One action through topic -> executor -> subscriber, no store: subtract
+// this from the store rows to get the reducer cost.
+PULSEUI_BENCH(store_baseline) {
+  pipeline<Bump> p;
+  std::uint64_t seen = 0;
+  auto sub = p.source().subscribe([&](const Bump& b) { seen += b.by; });
+  s.run("store.baseline", 256, [&] {
+    for (int i = 0; i < 256; ++i) p.in.publish(Bump{1});
+    p.ex.run_pending();
+  });
+  keep(seen);
+  sub.reset();
+}
+
+// make_store emits a Model copy per action: cost grows with the model.
+// make_shared_store mutates in place while nobody holds the last snapshot.
+PULSEUI_BENCH(store_reduce) {
+  for (std::size_t bytes : {16u, 1024u, 16384u, 262144u}) {
+    {
+      pipeline<Bump> p;
+      auto model = core::make_store<Blob, Bump>(p.source(), [bytes](Blob m, const Bump& a) {
+        if (m.data.size() != bytes) m.data.resize(bytes);
+        m.counter += a.by;
+        m.data[m.counter % bytes] ^= 1;
+        return m;
+      });
+      std::uint64_t last = 0;
+      auto sub = model.subscribe([&](const Blob& m) { last = m.counter; });
+      s.run("store.make_store/bytes=" + std::to_string(bytes), 64, [&] {
+        for (int i = 0; i < 64; ++i) p.in.publish(Bump{1});
+        p.ex.run_pending();
+      });
+      keep(last);
+      sub.reset();
+    }
+    {
+      pipeline<Bump> p;
+      Blob init;
+      init.data.resize(bytes);
+      auto model = core::make_shared_store<Blob, Bump>(
+        p.source(),
+        [bytes](Blob& m, const Bump& a) {
+          m.counter += a.by;
+          m.data[m.counter % bytes] ^= 1;
+        },
+        std::move(init));
+      std::uint64_t last = 0;
+      auto sub = model.subscribe([&](const std::shared_ptr<const Blob>& m) { last = m->counter; });
+      s.run("store.make_shared_store/bytes=" + std::to_string(bytes), 64, [&] {
+        for (int i = 0; i < 64; ++i) p.in.publish(Bump{1});
+        p.ex.run_pending();
+      });
+      keep(last);
+      sub.reset();
+    }
+  }
+}
+
+// distinct_until_changed on repeated vs. always-new values; the comparison
+// and the stored copy both scale with the value size.
+PULSEUI_BENCH(distinct_until_changed) {
+  for (std::size_t bytes : {16u, 4096u}) {
+    for (bool changing : {false, true}) {
+      pipeline<Blob> p;
+      std::uint64_t emitted = 0;
+      auto sub = (p.source() | pulse::distinct_until_changed()).subscribe([&](const Blob&) { ++emitted; });
+      Blob v;
+      v.data.resize(bytes);
+      s.run(std::string("reactive.distinct_until_changed/") + (changing ? "changing" : "repeated") +
+              "/bytes=" + std::to_string(bytes),
+            64, [&] {
+              for (int i = 0; i < 64; ++i) {
+                if (changing) ++v.counter;
+                p.in.publish(v);
+              }
+              p.ex.run_pending();
+            });
+      keep(emitted);
+      sub.reset();
+    }
+  }
+}
+
+// One 1ms tick of a wheel holding 100k timers spread over ten minutes, about
+// one of them due per tick; then arming and cancelling one more.
+PULSEUI_BENCH(timer_service) {
+  core::loop_executor ui;
+  core::manual_clock clock;
+  core::timer_service timers(ui, clock);
+  std::uint64_t fired = 0;
+  std::uint64_t seed = 1;
+  auto next = [&seed] { return seed = seed * 6364136223846793005ull + 1442695040888963407ull, seed >> 33; };
+  for (int i = 0; i < 100'000; ++i) {
+    timers.every(std::chrono::milliseconds(1 + next() % 600'000), [&fired] { ++fired; });
+  }
+  s.run("timers.tick/active=100k", 1, [&] {
+    clock.advance(std::chrono::milliseconds(1));
+    timers.poll();
+  });
+  s.run("timers.add_cancel/active=100k", 1, [&] { timers.cancel(timers.after(std::chrono::seconds(5), [] {})); });
+  keep(fired);
+}
+
+// --check: timer_service on a manual_clock (1ms resolution) stepped like a
+// UI loop would poll it. Every callback asserts it is not early; fire counts
+// cover one-shot (including a sub-tick delay that must round up), periodic,
+// a late poll skipping periods, cancel (also from inside the callback), a
+// deadline in the past and one far beyond the wheel's 2^30-tick reach.
+PULSEUI_BENCH(check_timer_service) {
+  using namespace std::chrono;
+  using ns = nanoseconds;
+  core::loop_executor ui;
+  core::manual_clock clock;
+  core::timer_service timers(ui, clock);
+  std::uint64_t early = 0;
+
+  struct probe {
+    ns due;
+    ns period{};
+    int fires{0};
+  };
+  auto fire = [&](probe& p) {
+    const ns now = clock.now();
+    if (now < p.due) ++early;
+    ++p.fires;
+    if (p.period.count() && p.due <= now) p.due += ((now - p.due) / p.period + 1) * p.period;
+  };
+  auto step_to = [&](ns t, ns step) {
+    while (clock.now() < t) {
+      clock.advance(std::min(step, t - clock.now()));
+      timers.poll();
+    }
+  };
+  auto expect_fires = [&](const char* what, const probe& p, int want) {
+    s.expect(p.fires == want, std::string("timers: ") + what + " fired " + std::to_string(p.fires) +
+                                " times, expected " + std::to_string(want));
+  };
+
+  probe once{milliseconds(10)}, sub_tick{microseconds(2500)}, tick7{milliseconds(7), milliseconds(7)};
+  probe cancelled{milliseconds(20)}, self_cancel{milliseconds(5), milliseconds(5)}, past{ns(0)};
+  timers.after(milliseconds(10), [&] { fire(once); });
+  timers.after(microseconds(2500), [&] { fire(sub_tick); });
+  timers.every(milliseconds(7), [&] { fire(tick7); });
+  const core::timer_id c = timers.after(milliseconds(20), [&] { fire(cancelled); });
+  core::timer_id self{};
+  self = timers.every(milliseconds(5), [&] {
+    fire(self_cancel);
+    if (self_cancel.fires == 3) timers.cancel(self);
+  });
+
+  step_to(milliseconds(2), milliseconds(1));
+  expect_fires("2.5ms one-shot at 2ms", sub_tick, 0);
+  step_to(milliseconds(5), milliseconds(1));
+  s.expect(timers.cancel(c), "timers: cancel of an armed timer returned false");
+  s.expect(!timers.cancel(c), "timers: second cancel returned true");
+  timers.at(milliseconds(1), [&] { fire(past); });
+  step_to(milliseconds(9), milliseconds(1));
+  expect_fires("10ms one-shot at 9ms", once, 0);
+  expect_fires("at() in the past", past, 1);
+  step_to(milliseconds(100), milliseconds(1));
+  expect_fires("10ms one-shot", once, 1);
+  expect_fires("2.5ms one-shot", sub_tick, 1);
+  expect_fires("7ms periodic over 100ms", tick7, 14);
+  expect_fires("cancelled one-shot", cancelled, 0);
+  expect_fires("periodic cancelling itself on its 3rd run", self_cancel, 3);
+
+  // One poll 95ms late: 13 periods (105..189ms) due, one run and 12 counted
+  // as missed, then back on the 7ms grid (196, 203, 210).
+  const std::uint64_t missed = timers.stats().missed;
+  clock.advance(milliseconds(95));
+  timers.poll();
+  expect_fires("7ms periodic after a 95ms late poll", tick7, 15);
+  s.expect(timers.stats().missed - missed == 12, "timers: late poll counted " +
+                                                     std::to_string(timers.stats().missed - missed) +
+                                                     " missed periods, expected 12");
+  step_to(milliseconds(210), milliseconds(1));
+  expect_fires("7ms periodic at 210ms", tick7, 18);
+
+  // Beyond the wheel: 2^31 ms (about 25 days) away, reached in hour steps.
+  const ns far_due = clock.now() + milliseconds(std::int64_t{1} << 31);
+  probe far{far_due};
+  timers.after(milliseconds(std::int64_t{1} << 31), [&] { fire(far); });
+  step_to(far_due - milliseconds(1), hours(1));
+  expect_fires("timer 2^31 ticks away, 1ms before its deadline", far, 0);
+  step_to(far_due, milliseconds(1));
+  expect_fires("timer 2^31 ticks away", far, 1);
+
+  s.expect(early == 0, "timers: " + std::to_string(early) + " callbacks ran before their deadline");
+}
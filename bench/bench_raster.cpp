@@ -0,0 +1,62 @@
+// Tile rasterizer scaling: an 8K dashboard-like frame rendered by a single
+// RasterCanvas replay and by TileRasterizer at 1..N threads.
+#include <string>
+#include <thread>
+#include <vector>
+#include <pulseui/platform/headless.hpp>
+#include <pulseui/ui/display_list.hpp>
+#include "harness.hpp"
+
+using namespace pulseui;
+using namespace pulseui::bench;
+
+namespace {
+
+constexpr int kWidth = 7680, kHeight = 4320;
+
+// Background, a grid of cards with a translucent header and two labels each.
+ui::DisplayList scene() {
+  ui::DisplayList dl;
+  dl.push_clear(ui::Color{0.08f, 0.08f, 0.1f, 1.f});
+  const float w = 180, h = 110;
+  int i = 0;
+  for (float y = 8; y + h < kHeight; y += h + 8) {
+    for (float x = 8; x + w < kWidth; x += w + 8, ++i) {
+      dl.push_fill_rect(ui::Rect{x, y, w, h}, ui::Color{0.18f, 0.2f + (i % 7) * 0.05f, 0.26f, 1.f});
+      dl.push_fill_rect(ui::Rect{x, y, w, 24}, ui::Color{1.f, 1.f, 1.f, 0.15f});
+      dl.push_text(ui::Point{x + 8, y + 4}, "Sensor " + std::to_string(i % 512), ui::Font{14.f}, ui::Color{1, 1, 1, 1});
+      dl.push_text(ui::Point{x + 8, y + 48}, std::to_string((i * 37) % 1000) + " units", ui::Font{24.f},
+                   ui::Color{0.6f, 0.9f, 0.6f, 1.f});
+    }
+  }
+  return dl;
+}
+
+} // namespace
+
+PULSEUI_BENCH(tile_raster) {
+  const ui::DisplayList dl = scene();
+  platform::Framebuffer fb;
+  fb.resize(kWidth, kHeight);
+  const double px = (double)kWidth * kHeight;
+
+  {
+    auto& r = s.run("raster.replay/8k", 1, [&] {
+      platform::RasterCanvas g(fb);
+      dl.replay(g);
+    });
+    r.counter("MP/s", px / r.ns_per_op * 1e3);
+  }
+
+  // Powers of two below the core count, then the core count itself.
+  const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<unsigned> counts;
+  for (unsigned t = 1; t < hw; t *= 2) counts.push_back(t);
+  counts.push_back(hw);
+  for (unsigned threads : counts) {
+    platform::TileRasterizer tiles(threads);
+    auto& r = s.run("raster.tiles/8k/threads=" + std::to_string(threads), 1, [&] { tiles.render(dl, fb); });
+    r.counter("MP/s", px / r.ns_per_op * 1e3);
+    r.counter("MP/s/thread", px / r.ns_per_op * 1e3 / threads);
+  }
+}
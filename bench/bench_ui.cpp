@@ -0,0 +1,332 @@
+// Canvas primitive, image, paint-callback text, widget paint/input, input queue and animation benchmarks on the headless raster
+// backend (in-memory framebuffer, no window system involved).
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <string>
+#include <vector>
+#include <pulseui/core/loop_executor.hpp>
+#include <pulseui/platform/headless.hpp>
+#include <pulseui/ui/animation.hpp>
+#include <pulseui/ui/button.hpp>
+#include <pulseui/ui/image_cache.hpp>
+#include <pulseui/ui/input_queue.hpp>
+#include <pulseui/ui/widget_container.hpp>
+#include <pulseui/ui/widget_pool.hpp>
+#include "harness.hpp"
+
+using namespace pulseui;
+using namespace pulseui::bench;
+using platform::Framebuffer;
+using platform::RasterCanvas;
+
+namespace {
+
+constexpr int kWidth = 1280, kHeight = 720;
+
+// Megapixels per second for an op touching px pixels.
+double mpps(const result& r, double px) { return r.ns_per_op > 0 ? px / r.ns_per_op * 1e3 : 0; }
+
+// Grid of cols x rows cells of w x h with a 2px gap.
+std::vector<ui::Rect> grid(int cols, int rows, float w, float h) {
+  std::vector<ui::Rect> out;
+  for (int y = 0; y < rows; ++y)
+    for (int x = 0; x < cols; ++x) out.push_back(ui::Rect{x * (w + 2), y * (h + 2), w, h});
+  return out;
+}
+
+// Pointer sweep across the grid with a click every 16 moves.
+std::vector<ui::InputEvent> sweep(float w, float h, int n) {
+  std::vector<ui::InputEvent> out;
+  for (int i = 0; i < n; ++i) {
+    const ui::Point p{(float)((i * 37) % (int)w), (float)((i * 11) % (int)h)};
+    out.push_back(ui::InputEvent{ui::InputEvent::MouseMove, p});
+    if (i % 16 == 0) {
+      out.push_back(ui::InputEvent{ui::InputEvent::MouseDown, p});
+      out.push_back(ui::InputEvent{ui::InputEvent::MouseUp, p});
+    }
+  }
+  return out;
+}
+
+} // namespace
+
+PULSEUI_BENCH(canvas_primitives) {
+  Framebuffer fb;
+  fb.resize(kWidth, kHeight);
+  RasterCanvas g(fb);
+  const ui::Color opaque{0.2f, 0.4f, 0.8f, 1.f};
+  const ui::Color blend{0.9f, 0.3f, 0.1f, 0.5f};
+
+  {
+    auto& r = s.run("canvas.clear/1280x720", 1, [&] { g.clear(opaque); });
+    r.counter("MP/s", mpps(r, kWidth * kHeight));
+  }
+  for (int side : {16, 256}) {
+    const std::string dim = std::to_string(side) + "x" + std::to_string(side);
+    int i = 0;
+    auto next = [&] {
+      i = (i + 97) % (kWidth - side);
+      return ui::Rect{(float)i, (float)(i % (kHeight - side)), (float)side, (float)side};
+    };
+    auto& a = s.run("canvas.fill_rect/opaque/" + dim, 1, [&] { g.fill_rect(next(), opaque); });
+    a.counter("MP/s", mpps(a, side * side));
+    auto& b = s.run("canvas.fill_rect/blend/" + dim, 1, [&] { g.fill_rect(next(), blend); });
+    b.counter("MP/s", mpps(b, side * side));
+  }
+  {
+    const ui::Font f{16.f};
+    s.run("canvas.draw_text/24chars", 1, [&] { g.draw_text({40, 40}, "The quick brown fox jump", f, opaque); });
+    s.run("canvas.measure_text/24chars", 1, [&] { keep(g.measure_text("The quick brown fox jump", f)); });
+  }
+}
+
+// A status board: 2000 16px icons from 64 distinct 64px images. The warm
+// row only samples cached mip levels; the cold row evicts everything first,
+// so each frame pays decode + mips again.
+PULSEUI_BENCH(image) {
+  std::vector<ui::Image> images;
+  for (std::uint32_t i = 0; i < 64; ++i) {
+    std::vector<std::uint32_t> px(64 * 64);
+    for (std::size_t k = 0; k < px.size(); ++k) px[k] = (k % 7 ? 0xFF000000u : 0x80000000u) | (i * 0x030507u + (std::uint32_t)k);
+    images.push_back(ui::Image::from_pixels(64, 64, std::move(px)));
+  }
+  const auto cells = grid(50, 40, 16, 16);
+  Framebuffer fb;
+  fb.resize(kWidth, kHeight);
+  auto paint = [&] {
+    RasterCanvas g(fb);
+    for (std::size_t i = 0; i < cells.size(); ++i) g.draw_image(cells[i], images[i % images.size()], 1.f);
+  };
+  paint();
+  auto& warm = s.run("image.draw/icons=2000/warm", 1, paint);
+  warm.counter("MP/s", mpps(warm, 2000.0 * 16 * 16));
+  s.run("image.draw/icons=2000/cold", 1, [&] {
+    ui::surface_cache().clear();
+    paint();
+  });
+}
+
+// The paint callback of 01_counter_reactive through a HeadlessWindow: the
+// label built with std::to_string versus draw_textf into the paint arena.
+// Counter values repeat, so text runs come from the backend's cache and the
+// draw_textf frame makes no allocation (checked by --check). That holds only
+// while every label is a cache hit: paint_with() warms all 100 of them first,
+// and a label the cache has not seen allocates its run.
+PULSEUI_BENCH(paint_text) {
+  auto win = platform::make_headless_window(640, 400, "bench");
+  int counter = 0;
+  auto frame = [&] {
+    counter = (counter + 1) % 100;
+    win->paint();
+  };
+  auto paint_with = [&](auto label) {
+    win->on_paint([&, label](ui::Canvas& g) {
+      g.clear({0.12f, 0.12f, 0.12f, 1});
+      g.fill_rect({24, 60, 200, 80}, {0.25f, 0.55f, 0.90f, 1});
+      label(g);
+    });
+    for (int i = 0; i < 100; ++i) frame(); // every label in the text cache
+  };
+
+  paint_with([&](ui::Canvas& g) {
+    g.draw_text({34, 110}, "Counter: " + std::to_string(counter) + " (" + std::to_string(counter * 1.5) + "%)",
+                ui::Font{20.f}, {1, 1, 1, 1});
+  });
+  s.run("paint.counter/to_string", 1, frame);
+
+  paint_with([&](ui::Canvas& g) {
+    g.draw_textf({34, 110}, ui::Font{20.f}, {1, 1, 1, 1}, "Counter: {} ({}%)", counter, counter * 1.5);
+  });
+  auto& r = s.run("paint.counter/draw_textf", 1, frame).expect_no_allocs();
+  r.counter("arena_peak_B", (double)ui::paint_arena().stats().peak);
+}
+
+// 1000 Buttons: full repaint, and input through a WidgetContainer.
+PULSEUI_BENCH(button) {
+  Framebuffer fb;
+  fb.resize(kWidth, kHeight);
+  const auto rects = grid(40, 25, 30, 26);
+  std::deque<ui::Button> buttons;
+  ui::WidgetContainer root;
+  std::uint64_t clicks = 0;
+  for (std::size_t i = 0; i < rects.size(); ++i) {
+    ui::Button& b = buttons.emplace_back(rects[i], std::to_string(i));
+    b.on_click([&clicks] { ++clicks; });
+    root.add(b);
+  }
+  const ui::Color bg{0.1f, 0.1f, 0.1f, 1.f};
+
+  s.run("widgets.button/paint/1000", 1, [&] {
+    RasterCanvas g(fb);
+    g.clear(bg);
+    root.paint(g);
+  });
+
+  const auto events = sweep(40 * 32, 25 * 28, 1024);
+  s.run("widgets.button/input/events", events.size(), [&] {
+    for (const ui::InputEvent& e : events) root.dispatch(e);
+  });
+  keep(clicks);
+}
+
+// The same grid as one ButtonPool.
+PULSEUI_BENCH(button_pool) {
+  Framebuffer fb;
+  fb.resize(kWidth, kHeight);
+  const auto rects = grid(40, 25, 30, 26);
+  ui::ButtonPool pool;
+  std::uint64_t clicks = 0;
+  const auto on_click = pool.add_handler([&clicks](ui::ButtonPool::id) { ++clicks; });
+  for (std::size_t i = 0; i < rects.size(); ++i) pool.add(rects[i], std::to_string(i), 0, on_click);
+  const ui::Color bg{0.1f, 0.1f, 0.1f, 1.f};
+
+  s.run("widgets.button_pool/paint/1000", 1, [&] {
+    RasterCanvas g(fb);
+    g.clear(bg);
+    pool.paint_all(g);
+  });
+
+  const auto events = sweep(40 * 32, 25 * 28, 1024);
+  s.run("widgets.button_pool/input/events", events.size(), [&] { pool.dispatch(events); });
+  keep(clicks);
+}
+
+// ButtonPool against Buttons in a WidgetContainer: the same grid and pointer
+// sweep at 1k and 10k buttons. x_widgets is pool time over container time,
+// so below 1 means the pool is faster.
+PULSEUI_BENCH(button_pool_vs_widgets) {
+  for (int rows : {25, 250}) {
+    const auto rects = grid(40, rows, 30, 26);
+    const auto events = sweep(40 * 32, (float)rows * 28, 1024);
+    const std::string n = std::to_string(rects.size());
+    std::uint64_t clicks = 0;
+
+    std::deque<ui::Button> buttons;
+    ui::WidgetContainer root;
+    for (std::size_t i = 0; i < rects.size(); ++i) {
+      ui::Button& b = buttons.emplace_back(rects[i], std::to_string(i));
+      b.on_click([&clicks] { ++clicks; });
+      root.add(b);
+    }
+    const double widgets_ns = s.run("widgets.compare/button/input/" + n, events.size(), [&] {
+      for (const ui::InputEvent& e : events) root.dispatch(e);
+    }).ns_per_op;
+
+    ui::ButtonPool pool;
+    const auto on_click = pool.add_handler([&clicks](ui::ButtonPool::id) { ++clicks; });
+    for (std::size_t i = 0; i < rects.size(); ++i) pool.add(rects[i], std::to_string(i), 0, on_click);
+    auto& r = s.run("widgets.compare/button_pool/input/" + n, events.size(), [&] { pool.dispatch(events); });
+    r.counter("x_widgets", widgets_ns > 0 ? r.ns_per_op / widgets_ns : 0);
+    keep(clicks);
+  }
+}
+
+// One animation frame over n running Color tweens with long durations, so
+// none finish while the benchmark runs; the callback only sums a lane.
+PULSEUI_BENCH(animator) {
+  for (int n : {1'000, 10'000}) {
+    core::loop_executor ui;
+    ui::Animator anim(ui);
+    float sum = 0;
+    for (int i = 0; i < n; ++i) {
+      anim.start(ui::Tween<ui::Color>{{0, 0, 0, 1}, {1, 1, 1, 1}, std::chrono::hours(1) + std::chrono::seconds(i),
+                                      ui::Ease::InOutCubic},
+                 [&sum](const ui::Color& c) { sum += c.r; });
+    }
+    auto t = std::chrono::steady_clock::now();
+    auto& r = s.run("animator.frame/tweens=" + std::to_string(n), 1, [&] {
+      t += std::chrono::microseconds(100);
+      anim.advance(t);
+    });
+    r.counter("ns/tween", r.ns_per_op / n);
+    keep(sum);
+  }
+}
+
+// A 1kHz mouse against a 60Hz frame: 16 raw moves and a 4-step scroll per
+// frame, a click every 4th frame; one op is one raw event pushed and
+// delivered. With history every raw move is kept for the batch as well.
+PULSEUI_BENCH(input_queue) {
+  std::vector<ui::InputEvent> frame;
+  for (int f = 0; f < 4; ++f) {
+    for (int i = 0; i < 16; ++i) {
+      frame.push_back(ui::InputEvent{ui::InputEvent::MouseMove, {(float)(f * 16 + i), (float)i}});
+    }
+    for (int i = 0; i < 4; ++i) frame.push_back(ui::InputEvent{ui::InputEvent::Scroll, {0, 0}, 0, 1.f});
+    if (f == 3) {
+      frame.push_back(ui::InputEvent{ui::InputEvent::MouseDown, {8, 8}});
+      frame.push_back(ui::InputEvent{ui::InputEvent::MouseUp, {8, 8}});
+    }
+  }
+  for (bool history : {false, true}) {
+    ui::InputQueue q(history);
+    std::uint64_t seen = 0;
+    auto& r = s.run(std::string("input.queue/push+flush") + (history ? "/history" : ""), frame.size(), [&] {
+      for (std::size_t i = 0; i < frame.size(); ++i) {
+        q.push(frame[i]);
+        if (i % 21 == 20 || i + 1 == frame.size()) {
+          q.flush([&](std::span<const ui::InputEvent> b) { seen += b.size() + q.delivered_move_history().size(); });
+        }
+      }
+    });
+    r.expect_no_allocs();
+    r.counter("delivered/raw", (double)q.stats().delivered / (double)q.stats().received);
+    keep(seen);
+  }
+}
+
+// --check: coalescing as seen through HeadlessWindow::on_input_batch. Runs
+// of moves collapse to the last one, runs of scrolls sum their deltas,
+// nothing merges across another event type, and move_history() holds every
+// raw move of the batch while it is delivered (and only then).
+PULSEUI_BENCH(check_input_queue) {
+  using E = ui::InputEvent;
+  auto win = platform::make_headless_window(64, 64, "check");
+  std::vector<E> batch, history;
+  win->on_input_batch([&](std::span<const E> b) {
+    batch.assign(b.begin(), b.end());
+    history.assign(win->move_history().begin(), win->move_history().end());
+  });
+  const std::vector<E> raw = {
+    {E::MouseMove, {1, 1}}, {E::MouseMove, {2, 2}}, {E::MouseMove, {3, 3}},
+    {E::Scroll, {3, 3}, 0, 1.f}, {E::Scroll, {3, 3}, 0, 2.f}, {E::Scroll, {4, 4}, 0, -0.5f},
+    {E::MouseDown, {4, 4}}, {E::MouseMove, {5, 5}}, {E::MouseMove, {6, 6}}, {E::MouseUp, {6, 6}},
+    {E::Scroll, {6, 6}, 0, 1.f}, {E::MouseMove, {7, 7}}, {E::Scroll, {7, 7}, 0, 1.f},
+  };
+  auto same = [](const E& a, E::Type t, float x, float scroll, std::uint32_t n) {
+    return a.type == t && a.pos.x == x && a.scrollY == scroll && a.coalesced == n;
+  };
+
+  for (bool keep_history : {false, true}) {
+    const std::string tag = keep_history ? "input.queue(history): " : "input.queue: ";
+    win->set_keep_move_history(keep_history);
+    for (const E& e : raw) win->send_input(e);
+    s.expect(win->flush_input(), tag + "nothing delivered");
+    s.expect(batch.size() == 8, tag + std::to_string(batch.size()) + " events in the batch, expected 8");
+    if (batch.size() == 8) {
+      s.expect(same(batch[0], E::MouseMove, 3, 0, 3), tag + "three moves did not collapse into the last");
+      s.expect(same(batch[1], E::Scroll, 4, 2.5f, 3), tag + "scroll deltas did not sum to 2.5");
+      s.expect(same(batch[2], E::MouseDown, 4, 0, 1), tag + "MouseDown changed");
+      s.expect(same(batch[3], E::MouseMove, 6, 0, 2), tag + "moves after MouseDown did not collapse");
+      s.expect(same(batch[4], E::MouseUp, 6, 0, 1), tag + "MouseUp changed");
+      s.expect(same(batch[5], E::Scroll, 6, 1, 1) && same(batch[6], E::MouseMove, 7, 0, 1) &&
+                 same(batch[7], E::Scroll, 7, 1, 1),
+               tag + "events merged across another event type");
+    }
+    bool in_order = history.size() == (keep_history ? 6u : 0u);
+    for (std::size_t i = 0; in_order && i < history.size(); ++i) {
+      const float want[] = {1, 2, 3, 5, 6, 7};
+      in_order = history[i].type == E::MouseMove && history[i].pos.x == want[i];
+    }
+    s.expect(in_order, tag + "move_history() has " + std::to_string(history.size()) + " moves, expected " +
+                           (keep_history ? "1,2,3,5,6,7" : "none"));
+    s.expect(win->move_history().empty(), tag + "move_history() not empty outside the batch callback");
+    s.expect(!win->flush_input(), tag + "second flush delivered again");
+  }
+  s.run("input.queue/window_batch", raw.size(), [&] {
+    for (const E& e : raw) win->send_input(e);
+    win->flush_input();
+  });
+}
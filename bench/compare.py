@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+"""Compare two PulseUI_bench runs (JSON or CSV output).
+
+    PulseUI_bench --format json --out before.json
+    ... change things, rebuild ...
+    PulseUI_bench --format json --out after.json
+    bench/compare.py before.json after.json --threshold 5
+
+Prints ns/op and allocs/op side by side with the relative change. Exits with
+status 1 when any row got slower than the threshold (percent), so it can gate CI.
+"""
+import argparse
+import csv
+import json
+import sys
+
+
+def load(path):
+    with open(path, newline="") as f:
+        if path.endswith(".csv"):
+            return {r["name"]: {k: float(v) for k, v in r.items() if k not in ("name", "counters") and v}
+                    for r in csv.DictReader(f)}
+        return {r["name"]: r for r in json.load(f)["results"]}
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("before")
+    ap.add_argument("after")
+    ap.add_argument("--threshold", type=float, default=5.0,
+                    help="slowdown in percent that counts as a regression (default 5)")
+    ap.add_argument("--filter", default="", help="only rows whose name contains this")
+    args = ap.parse_args()
+
+    a, b = load(args.before), load(args.after)
+    names = [n for n in a if n in b and args.filter in n]
+    if not names:
+        print("no common rows", file=sys.stderr)
+        return 2
+
+    width = max(len(n) for n in names)
+    print(f"{'name':<{width}}  {'before ns':>12} {'after ns':>12} {'change':>8}  {'allocs':>13}")
+    regressions = 0
+    for n in names:
+        x, y = a[n]["ns_per_op"], b[n]["ns_per_op"]
+        change = (y - x) / x * 100.0 if x > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  SLOWER"
+            regressions += 1
+        elif change < -args.threshold:
+            flag = "  faster"
+        allocs = f"{a[n]['allocs_per_op']:.2f}->{b[n]['allocs_per_op']:.2f}"
+        print(f"{n:<{width}}  {x:12.1f} {y:12.1f} {change:+7.1f}%  {allocs:>13}{flag}")
+
+    for n in sorted(set(a) ^ set(b)):
+        print(f"{n}: only in {'before' if n in a else 'after'}")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,201 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Minimal benchmark harness for PulseUI_bench (no external dependencies).
+//
+//   PULSEUI_BENCH(canvas_fill) {
+//     RasterCanvas g(fb);
+//     s.run("canvas.fill_rect/32x32", 1, [&]{ g.fill_rect(r, c); });
+//   }
+//
+// Every run() is one result row: median ns/op over several samples, the
+// min/max sample, heap allocations per op and optional latency percentiles
+// and counters. s.expect(ok, "what") records a failed correctness check.
+
+namespace pulseui::bench {
+
+// Heap allocations made by this process so far (see alloc_counter.cpp).
+struct alloc_totals {
+  std::uint64_t count{};
+  std::uint64_t bytes{};
+};
+alloc_totals allocations();
+
+// Keeps the compiler from discarding a computed value.
+template <class T>
+inline void keep(T&& v) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(v) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &v;
+#endif
+}
+
+struct result {
+  std::string name;
+  std::uint64_t ops{};       // operations timed, all samples
+  double ns_per_op{};        // median sample
+  double ns_per_op_min{};
+  double ns_per_op_max{};
+  double allocs_per_op{};
+  double bytes_per_op{};
+  double p50_ns{};           // latency percentiles, 0 when not measured
+  double p99_ns{};
+  std::vector<std::pair<std::string, double>> counters; // e.g. {"MP/s", 812.4}
+  bool no_allocs{};          // PulseUI_bench --check fails if this row allocated
+
+  result& counter(std::string key, double v) {
+    counters.emplace_back(std::move(key), v);
+    return *this;
+  }
+
+  // Marks a row whose steady state must not touch the heap.
+  result& expect_no_allocs() {
+    no_allocs = true;
+    return *this;
+  }
+};
+
+struct options {
+  double min_time_ms{200}; // per result row
+  int samples{7};
+};
+
+// Fills p50_ns/p99_ns from latency samples (reorders them).
+inline void latency_percentiles(std::vector<std::uint64_t>& ns, result& r) {
+  if (ns.empty()) return;
+  auto at = [&](double q) {
+    const auto k = (std::size_t)(q * (double)(ns.size() - 1) + 0.5);
+    std::nth_element(ns.begin(), ns.begin() + (std::ptrdiff_t)k, ns.end());
+    return (double)ns[k];
+  };
+  r.p50_ns = at(0.50);
+  r.p99_ns = at(0.99);
+}
+
+inline std::uint64_t now_ns() {
+  return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+class state {
+public:
+  explicit state(const options& opt) : opt_(opt) {}
+
+  // Times body(), which performs ops operations per call. The number of
+  // calls per sample is calibrated so all samples take about min_time_ms.
+  template <class F>
+  result& run(std::string name, std::uint64_t ops, F&& body) {
+    body(); // warm caches, pools and lazy state
+    const double target_ns = opt_.min_time_ms * 1e6 / (double)std::max(1, opt_.samples);
+    std::uint64_t calls = 1;
+    for (;;) {
+      const std::uint64_t t0 = now_ns();
+      for (std::uint64_t i = 0; i < calls; ++i) body();
+      const double took = (double)(now_ns() - t0);
+      if (took >= target_ns * 0.5 || calls >= (1ull << 30)) {
+        if (took > 0) calls = std::max<std::uint64_t>(1, (std::uint64_t)((double)calls * target_ns / took));
+        break;
+      }
+      calls *= 4;
+    }
+
+    std::vector<double> per_op;
+    per_op.reserve((std::size_t)std::max(1, opt_.samples)); // keeps the alloc count exact
+    const alloc_totals a0 = allocations();
+    for (int s = 0; s < std::max(1, opt_.samples); ++s) {
+      const std::uint64_t t0 = now_ns();
+      for (std::uint64_t i = 0; i < calls; ++i) body();
+      per_op.push_back((double)(now_ns() - t0) / (double)(calls * ops));
+    }
+    const alloc_totals a1 = allocations();
+
+    result r;
+    r.name = std::move(name);
+    r.ops  = calls * ops * per_op.size();
+    std::sort(per_op.begin(), per_op.end());
+    r.ns_per_op     = per_op[per_op.size() / 2];
+    r.ns_per_op_min = per_op.front();
+    r.ns_per_op_max = per_op.back();
+    r.allocs_per_op = (double)(a1.count - a0.count) / (double)r.ops;
+    r.bytes_per_op  = (double)(a1.bytes - a0.bytes) / (double)r.ops;
+    return add(std::move(r));
+  }
+
+  // Times one call of body() doing ops operations (for multi-threaded
+  // benchmarks that manage their own loop). Repeated samples times.
+  template <class F>
+  result& run_once(std::string name, std::uint64_t ops, F&& body) {
+    std::vector<double> per_op;
+    per_op.reserve((std::size_t)std::max(1, opt_.samples)); // keeps the alloc count exact
+    const alloc_totals a0 = allocations();
+    for (int s = 0; s < std::max(1, opt_.samples); ++s) {
+      const std::uint64_t t0 = now_ns();
+      body();
+      per_op.push_back((double)(now_ns() - t0) / (double)ops);
+    }
+    const alloc_totals a1 = allocations();
+
+    result r;
+    r.name = std::move(name);
+    r.ops  = ops * per_op.size();
+    std::sort(per_op.begin(), per_op.end());
+    r.ns_per_op     = per_op[per_op.size() / 2];
+    r.ns_per_op_min = per_op.front();
+    r.ns_per_op_max = per_op.back();
+    r.allocs_per_op = (double)(a1.count - a0.count) / (double)r.ops;
+    r.bytes_per_op  = (double)(a1.bytes - a0.bytes) / (double)r.ops;
+    return add(std::move(r));
+  }
+
+  result& add(result r) {
+    results_.push_back(std::move(r));
+    return results_.back();
+  }
+
+  // Correctness checks that ride along with a benchmark; a failure is
+  // reported, and makes PulseUI_bench --check exit with status 1.
+  bool expect(bool ok, std::string what) {
+    if (!ok) failures_.push_back(std::move(what));
+    return ok;
+  }
+
+  const options& opt() const { return opt_; }
+  std::vector<result>& results() { return results_; }
+  const std::vector<std::string>& failures() const { return failures_; }
+
+private:
+  const options& opt_;
+  std::vector<result> results_;
+  std::vector<std::string> failures_;
+};
+
+// === Registration ===
+struct entry {
+  const char* name;
+  void (*fn)(state&);
+};
+
+inline std::vector<entry>& registry() {
+  static std::vector<entry> r;
+  return r;
+}
+
+struct registrar {
+  registrar(const char* name, void (*fn)(state&)) { registry().push_back(entry{name, fn}); }
+};
+
+} // namespace pulseui::bench
+
+#define PULSEUI_BENCH(id)                                                   \
+  static void pulseui_bench_##id(::pulseui::bench::state& s);               \
+  static ::pulseui::bench::registrar pulseui_bench_reg_##id{#id, &pulseui_bench_##id}; \
+  static void pulseui_bench_##id([[maybe_unused]] ::pulseui::bench::state& s)
@@ -0,0 +1,155 @@
+// PulseUI_bench: runs the registered benchmarks and prints one row per result.
+//
+//   PulseUI_bench                          table on stdout
+//   PulseUI_bench --format json --out a.json
+//   PulseUI_bench --filter canvas --min-time 500 --samples 9
+//   PulseUI_bench --list
+//   PulseUI_bench --check --filter paint  exit status 1 if a row marked
+//                                         expect_no_allocs() allocated or
+//                                         an s.expect() check failed
+//
+// Compare two runs with bench/compare.py.
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <pulseui/platform/headless.hpp>
+#include "harness.hpp"
+
+namespace {
+
+using pulseui::bench::result;
+
+std::string json_escape(const std::string& s) {
+  std::string out;
+  for (char c : s) {
+    if (c == '"' || c == '\\') out += '\\';
+    out += c;
+  }
+  return out;
+}
+
+std::string compiler() {
+#if defined(__clang__)
+  return "clang " __clang_version__;
+#elif defined(__GNUC__)
+  return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+  return "msvc " + std::to_string(_MSC_VER);
+#else
+  return "unknown";
+#endif
+}
+
+void write_json(std::ostream& os, const std::vector<result>& rows) {
+  os << "{\n  \"context\": {\"compiler\": \"" << json_escape(compiler()) << "\", \"kernels\": \""
+     << pulseui::platform::raster_simd_level() << "\", \"threads\": " << std::thread::hardware_concurrency()
+     << ", \"time\": " << (long long)std::time(nullptr) << "},\n  \"results\": [";
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    const result& r = rows[i];
+    os << (i ? ",\n" : "\n") << "    {\"name\": \"" << json_escape(r.name) << "\", \"ops\": " << r.ops
+       << ", \"ns_per_op\": " << r.ns_per_op << ", \"ns_per_op_min\": " << r.ns_per_op_min
+       << ", \"ns_per_op_max\": " << r.ns_per_op_max << ", \"allocs_per_op\": " << r.allocs_per_op
+       << ", \"bytes_per_op\": " << r.bytes_per_op << ", \"p50_ns\": " << r.p50_ns << ", \"p99_ns\": " << r.p99_ns
+       << ", \"counters\": {";
+    for (std::size_t k = 0; k < r.counters.size(); ++k) {
+      os << (k ? ", " : "") << '"' << json_escape(r.counters[k].first) << "\": " << r.counters[k].second;
+    }
+    os << "}}";
+  }
+  os << "\n  ]\n}\n";
+}
+
+// Counters are flattened into one "key=value;key=value" column.
+void write_csv(std::ostream& os, const std::vector<result>& rows) {
+  os << "name,ops,ns_per_op,ns_per_op_min,ns_per_op_max,allocs_per_op,bytes_per_op,p50_ns,p99_ns,counters\n";
+  for (const result& r : rows) {
+    os << r.name << ',' << r.ops << ',' << r.ns_per_op << ',' << r.ns_per_op_min << ',' << r.ns_per_op_max << ','
+       << r.allocs_per_op << ',' << r.bytes_per_op << ',' << r.p50_ns << ',' << r.p99_ns << ',';
+    for (std::size_t k = 0; k < r.counters.size(); ++k) {
+      os << (k ? ";" : "") << r.counters[k].first << '=' << r.counters[k].second;
+    }
+    os << '\n';
+  }
+}
+
+void print_row(const result& r) {
+  std::printf("%-44s %12.1f ns/op  (%9.1f..%9.1f)  %7.2f alloc/op", r.name.c_str(), r.ns_per_op,
+              r.ns_per_op_min, r.ns_per_op_max, r.allocs_per_op);
+  if (r.p99_ns > 0) std::printf("  p50 %.0f ns  p99 %.0f ns", r.p50_ns, r.p99_ns);
+  for (const auto& [k, v] : r.counters) std::printf("  %s %.1f", k.c_str(), v);
+  std::printf("\n");
+  std::fflush(stdout);
+}
+
+int usage() {
+  std::fprintf(stderr,
+               "usage: PulseUI_bench [--filter SUBSTR] [--format table|json|csv] [--out FILE]\n"
+               "                     [--min-time MS] [--samples N] [--list] [--check]\n");
+  return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  using namespace pulseui::bench;
+
+  options opt;
+  std::string filter, format = "table", out;
+  bool list = false, check = false;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    auto value = [&]() -> const char* { return i + 1 < argc ? argv[++i] : nullptr; };
+    if (a == "--list") {
+      list = true;
+    } else if (a == "--check") {
+      check = true;
+    } else if (a == "--filter" || a == "--format" || a == "--out" || a == "--min-time" || a == "--samples") {
+      const char* v = value();
+      if (!v) return usage();
+      if (a == "--filter") filter = v;
+      else if (a == "--format") format = v;
+      else if (a == "--out") out = v;
+      else if (a == "--min-time") opt.min_time_ms = std::atof(v);
+      else opt.samples = std::atoi(v);
+    } else {
+      return usage();
+    }
+  }
+  if (format != "table" && format != "json" && format != "csv") return usage();
+
+  state s(opt);
+  for (const entry& e : registry()) {
+    if (list) { std::printf("%s\n", e.name); continue; }
+    if (!filter.empty() && std::strstr(e.name, filter.c_str()) == nullptr) continue;
+    const std::size_t first = s.results().size();
+    e.fn(s);
+    if (format == "table" || !out.empty()) {
+      for (std::size_t i = first; i < s.results().size(); ++i) print_row(s.results()[i]);
+    }
+  }
+  int status = 0;
+  for (const std::string& f : s.failures()) std::fprintf(stderr, "check failed: %s\n", f.c_str());
+  if (check) {
+    if (!s.failures().empty()) status = 1;
+    for (const result& r : s.results()) {
+      if (!r.no_allocs || r.allocs_per_op == 0) continue;
+      std::fprintf(stderr, "check failed: %s made %.3f alloc/op, expected none\n", r.name.c_str(), r.allocs_per_op);
+      status = 1;
+    }
+  }
+  if (list || format == "table") return status;
+
+  if (out.empty()) {
+    format == "json" ? write_json(std::cout, s.results()) : write_csv(std::cout, s.results());
+  } else {
+    std::ofstream f(out);
+    if (!f) { std::fprintf(stderr, "cannot write %s\n", out.c_str()); return 1; }
+    format == "json" ? write_json(f, s.results()) : write_csv(f, s.results());
+  }
+  return status;
+}
@@ -18,6 +18,10 @@ int main() {
 
   auto win  = platform::make_window(640, 400, "Counter (Reactive)");
 
+  // Coalesces model emissions into at most one repaint per frame.
+  frame_scheduler frames(*ui_exec);
+  frames.on_frame([&](const frame_info&){ win->invalidate(); });
+
   pulse::topic<Action> actions;
 
   auto model$ =
@@ -33,7 +37,7 @@ int main() {
   Model state{};
   auto sub = model$.subscribe([&](const Model& m){
     state = m;
-    win->invalidate();
+    frames.request_frame();
   });
 
   win->on_input([&](const ui::InputEvent& e){
@@ -46,7 +50,7 @@ int main() {
     g.clear({0.12f,0.12f,0.12f,1});
     g.draw_text({24,32}, "Click to increment the counter", ui::Font{16.f}, {1,1,1,1});
     g.fill_rect({24,60,200,80}, {0.25f,0.55f,0.90f,1});
-    g.draw_text({34,110}, "Counter: " + std::to_string(state.counter), ui::Font{20.f}, {1,1,1,1});
+    g.draw_textf({34,110}, ui::Font{20.f}, {1,1,1,1}, "Counter: {}", state.counter);
   });
 
   platform::app_run();
@@ -6,37 +6,42 @@ using namespace pulseui::ui;
 int main() {
   platform::app_init();
 
+  auto ui_exec = platform::make_ui_executor();
   auto win = platform::make_window(640, 400, "PulseUI Button");
 
+  // Damage from all input events of a frame is flushed to the window at once.
+  Region damage;
+  core::frame_scheduler frames(*ui_exec);
+  frames.on_frame([&](const core::frame_info&){
+    for (const Rect& r : damage.rects()) win->invalidate(r);
+    damage.clear();
+  });
+  auto repaint = [&](Rect r){ damage.add(r); frames.request_frame(); };
+
+  // Hover and press fade through one shared animation clock.
+  Animator anim(*ui_exec);
+
   Button btn(Rect{40, 40, 200, 48}, "Click me");
+  btn.set_animator(&anim);
   btn.on_click([&]{
     static int n = 0;
     btn.set_text("Clicked: " + std::to_string(++n));
-    win->invalidate();
   });
 
+  // The container routes input to the widget under the pointer and reports
+  // which widgets need repainting.
+  WidgetContainer root;
+  root.on_invalidate(repaint);
+  root.add(btn);
+
   win->on_paint([&](Canvas& g){
     g.clear({0.10f, 0.12f, 0.14f, 1.0f});
-    btn.paint(g);
+    root.paint(g);
   });
 
-  win->on_input([&](const InputEvent& e){
-    switch (e.type) {
-      case InputEvent::MouseMove:
-        btn.handle_mouse_move(e.pos);
-        win->invalidate();
-        break;
-      case InputEvent::MouseDown:
-        btn.handle_mouse_down(e.pos, MouseButton::Left);
-        win->invalidate();
-        break;
-      case InputEvent::MouseUp:
-        btn.handle_mouse_up(e.pos, MouseButton::Left);
-        win->invalidate();
-        break;
-      default:
-        break;
-    }
+  // Moves are coalesced by the window, so a fast mouse costs one hit test per frame.
+  win->on_input_batch([&](std::span<const InputEvent> batch){
+    for (const InputEvent& e : batch) root.dispatch(e);
   });
 
   platform::app_run();
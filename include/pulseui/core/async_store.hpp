@@ -0,0 +1,196 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <pulse/pulse.hpp>
+#include <pulseui/core/executor.hpp>
+#include <pulseui/core/loop_executor.hpp>
+#include <pulseui/core/mpsc_queue.hpp>
+#include <pulseui/core/profiler.hpp>
+#include <pulseui/core/reactive.hpp>
+#include <pulseui/core/store.hpp>
+#include <pulseui/core/task.hpp>
+#include <pulseui/core/triple_buffer.hpp>
+
+namespace pulseui::core {
+
+struct async_stats {
+  std::uint64_t actions{};
+  std::uint64_t batches{};       // reductions passes, one snapshot each
+  std::uint64_t max_batch{};
+  std::uint64_t notifications{}; // UI wake-ups posted
+};
+
+// Store whose reducer runs off the UI thread. Actions are queued lock-free;
+// a worker (a dedicated thread, or any core::executor such as a thread pool)
+// reduces everything queued since its last pass and publishes one snapshot
+// through a triple buffer. The UI thread reads the latest complete model with
+// latest(), which never blocks and never copies, so paint always has a model
+// no matter how long the reducer takes.
+//
+//   async_store<Model, Action> store(pulse::as_observable(actions, pex), reducer, *ui_exec);
+//   auto sub = store.changes().subscribe([&](auto&&){ frames.request_frame(); });
+//   win->on_paint([&](Canvas& g){ const Model& m = store.latest(); ... });
+//
+// Reducers are the same as for make_shared_store. The triple buffer always
+// holds the last published snapshot, so every pass copies the model once (its
+// first action works on a copy, the rest in place); big models want
+// cow<T>/shared_vector/shared_map fields to make that copy cheap. latest(),
+// snapshot() and changes() subscribers belong to the UI thread (the one
+// behind the ui executor).
+template <class Model, class Action>
+class async_store {
+public:
+  using Snapshot = std::shared_ptr<const Model>;
+
+  // Reduces on a dedicated worker thread owned by the store.
+  template <class Reducer>
+  async_store(pulse::observable<Action> actions, Reducer reducer, executor& ui, Model initial = Model{})
+    : own_(std::make_unique<worker>()) {
+    init(std::move(actions), std::move(reducer), own_->ex, ui, std::move(initial));
+  }
+
+  // Reduces on `work`. Passes never overlap, even on a thread pool.
+  template <class Reducer>
+  async_store(pulse::observable<Action> actions, Reducer reducer, executor& work, executor& ui,
+              Model initial = Model{}) {
+    init(std::move(actions), std::move(reducer), work, ui, std::move(initial));
+  }
+
+  ~async_store() {
+    if (sub_) sub_.reset();
+    own_.reset(); // finishes the passes already posted to the owned worker
+  }
+
+  async_store(const async_store&) = delete;
+  async_store& operator=(const async_store&) = delete;
+
+  // Any thread. Same as an action arriving on the input observable.
+  void dispatch(Action a) { enqueue(st_, std::move(a)); }
+
+  // UI thread. The latest complete model; stays valid until the next
+  // latest()/snapshot() call.
+  const Model& latest() {
+    st_->snapshots.update();
+    return *st_->snapshots.front();
+  }
+
+  // UI thread. The latest snapshot, to keep beyond the next latest() call.
+  Snapshot snapshot() {
+    st_->snapshots.update();
+    return st_->snapshots.front();
+  }
+
+  // The latest snapshot, delivered on the UI executor after new snapshots
+  // were published. Coalesced: at most one delivery is pending at a time.
+  pulse::observable<Snapshot> changes() { return pulse::as_observable(st_->out, st_->inline_pex); }
+
+  async_stats stats() const {
+    async_stats s;
+    s.actions       = st_->actions.load(std::memory_order_relaxed);
+    s.batches       = st_->batches.load(std::memory_order_relaxed);
+    s.max_batch     = st_->max_batch.load(std::memory_order_relaxed);
+    s.notifications = st_->notifications.load(std::memory_order_relaxed);
+    return s;
+  }
+
+private:
+  struct action_node : mpsc_node {
+    explicit action_node(Action a) : action(std::move(a)) {}
+    Action action;
+
+    static void* operator new(std::size_t) { return detail::block_pool<sizeof(action_node)>::allocate(); }
+    static void operator delete(void* p) noexcept { detail::block_pool<sizeof(action_node)>::deallocate(p); }
+  };
+
+  // Runs the topic's subscribers right away; changes() is published on the UI thread already.
+  struct inline_executor final : pulse::executor {
+    void post(std::function<void()> fn) override { fn(); }
+  };
+
+  struct state {
+    state(executor& w, executor& u, Snapshot initial) : work(w), ui(u), snapshots(initial) {}
+    ~state() { while (action_node* n = queue.pop()) delete n; }
+
+    executor& work;
+    executor& ui;
+    inline_executor inline_pex;
+    std::function<void(std::shared_ptr<Model>&, const Action&)> reduce;
+
+    mpsc_queue<action_node> queue;
+    std::mutex pass_mx;             // one pass at a time (the queue has one consumer)
+    std::shared_ptr<Model> current; // guarded by pass_mx
+    triple_buffer<Snapshot> snapshots;
+    pulse::topic<Snapshot> out;
+
+    std::atomic<std::uint64_t> actions{0}, batches{0}, max_batch{0}, notifications{0};
+  };
+
+  // Dedicated reducer thread.
+  struct worker {
+    loop_executor ex;
+    std::thread thread{[this] { ex.run(); }};
+    ~worker() {
+      ex.stop();
+      thread.join();
+    }
+  };
+
+  template <class Reducer>
+  void init(pulse::observable<Action> actions, Reducer reducer, executor& work, executor& ui, Model initial) {
+    auto model = std::make_shared<Model>(std::move(initial));
+    st_ = std::make_shared<state>(work, ui, Snapshot(model));
+    st_->current = std::move(model);
+    st_->reduce  = [r = std::move(reducer)](std::shared_ptr<Model>& cur, const Action& a) mutable {
+      detail::reduce_snapshot(cur, r, a);
+    };
+    std::weak_ptr<state> weak = st_;
+    sub_ = actions.subscribe([weak](const Action& a) {
+      if (auto st = weak.lock()) enqueue(st, a);
+    });
+  }
+
+  static void enqueue(const std::shared_ptr<state>& st, Action a) {
+    if (st->queue.push(new action_node(std::move(a)))) st->work.post([st] { run_pass(st); });
+  }
+
+  // Worker. Reduces everything queued, publishes one snapshot and wakes the
+  // UI if it had already seen the previous one.
+  static void run_pass(const std::shared_ptr<state>& st) {
+    PULSEUI_PROFILE_SCOPE("store.async_pass");
+    std::lock_guard<std::mutex> lock(st->pass_mx);
+    st->queue.begin_drain();
+    std::uint64_t n = 0;
+    while (action_node* node = st->queue.pop()) {
+      std::unique_ptr<action_node> owned(node);
+      st->reduce(st->current, owned->action);
+      ++n;
+    }
+    if (n == 0) return;
+
+    st->actions.fetch_add(n, std::memory_order_relaxed);
+    st->batches.fetch_add(1, std::memory_order_relaxed);
+    if (n > st->max_batch.load(std::memory_order_relaxed)) st->max_batch.store(n, std::memory_order_relaxed);
+
+    st->snapshots.back() = st->current; // releases the oldest snapshot here, off the UI thread
+    if (st->snapshots.publish()) {
+      st->notifications.fetch_add(1, std::memory_order_relaxed);
+      st->ui.post([st] {
+        st->snapshots.update();
+        st->out.publish(st->snapshots.front());
+      });
+    }
+  }
+
+  std::unique_ptr<worker> own_;
+  std::shared_ptr<state> st_;
+  pulse::subscription sub_;
+};
+
+} // namespace pulseui::core
@@ -0,0 +1,215 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <pulse/pulse.hpp>
+#include <pulseui/core/executor.hpp>
+#include <pulseui/core/reactive.hpp>
+#include <pulseui/core/store.hpp>
+
+namespace pulseui::core {
+
+struct batch_stats {
+  std::uint64_t actions{};
+  std::uint64_t batches{};
+  std::uint64_t last_batch{};
+  std::uint64_t max_batch{};
+  // histogram[i] counts batches of size in [2^i, 2^(i+1))
+  std::array<std::uint64_t, 16> histogram{};
+
+  double mean_batch() const { return batches ? (double)actions / (double)batches : 0.0; }
+};
+
+// Store that folds every action that arrived since the last flush through the
+// reducer in one pass and emits a single snapshot for the lot. Reducers are
+// the same as for make_shared_store; the snapshot is copied at most once per
+// batch. As there, hold snapshots by shared_ptr, never by weak_ptr.
+//
+// Flushing:
+//   batch_mode::post   - the first action of a batch posts flush() to the
+//                        executor, so a burst collapses into one emission
+//                        (per UI-loop turn with the UI executor, per task
+//                        with a thread pool).
+//   batch_mode::manual - only flush() flushes, e.g. from frame_scheduler's
+//                        on_frame, giving at most one emission per frame.
+// A transaction suspends automatic flushing until it ends.
+enum class batch_mode { post, manual };
+
+template <class Model, class Action>
+class batched_store {
+public:
+  using Snapshot = std::shared_ptr<const Model>;
+
+  template <class Reducer>
+  batched_store(pulse::observable<Action> actions, Reducer reducer, executor& ex,
+                batch_mode mode = batch_mode::post, Model initial = Model{})
+    : st_(std::make_shared<state>(ex, mode)) {
+    st_->current = std::make_shared<Model>(std::move(initial));
+    st_->reduce  = [r = std::move(reducer)](std::shared_ptr<Model>& cur, const Action& a) mutable {
+      detail::reduce_snapshot(cur, r, a);
+    };
+    std::weak_ptr<state> weak = st_;
+    sub_ = actions.subscribe([weak](const Action& a) {
+      if (auto st = weak.lock()) enqueue(st, a);
+    });
+  }
+
+  ~batched_store() { if (sub_) sub_.reset(); }
+
+  batched_store(const batched_store&) = delete;
+  batched_store& operator=(const batched_store&) = delete;
+
+  // One snapshot per flushed batch, delivered through the store's executor.
+  pulse::observable<Snapshot> changes() { return pulse::as_observable(st_->out, st_->pex); }
+
+  // Any thread. Same as an action arriving on the input observable.
+  void dispatch(Action a) { enqueue(st_, std::move(a)); }
+
+  // Any thread. Reduces everything pending and emits once. Returns the batch size.
+  std::size_t flush() { return do_flush(st_); }
+
+  // While a transaction is open, actions only accumulate; the batch is
+  // flushed when the last open transaction ends.
+  class transaction {
+  public:
+    explicit transaction(batched_store& s) : st_(s.st_) {
+      std::lock_guard<std::mutex> lock(st_->mx);
+      ++st_->open_tx;
+    }
+    ~transaction() {
+      bool last;
+      {
+        std::lock_guard<std::mutex> lock(st_->mx);
+        last = --st_->open_tx == 0;
+      }
+      if (last) do_flush(st_);
+    }
+    transaction(const transaction&) = delete;
+    transaction& operator=(const transaction&) = delete;
+
+  private:
+    std::shared_ptr<typename batched_store::state> st_;
+  };
+
+  transaction begin() { return transaction(*this); }
+
+  // Latest emitted snapshot.
+  Snapshot current() const {
+    std::lock_guard<std::mutex> lock(st_->flush_mx);
+    return st_->published;
+  }
+
+  batch_stats stats() const {
+    std::lock_guard<std::mutex> lock(st_->flush_mx);
+    return st_->stats;
+  }
+
+private:
+  struct state {
+    state(executor& e, batch_mode m) : ex(e), pex(e), mode(m) {}
+
+    executor& ex;
+    pulse_executor_adapter pex;
+    batch_mode mode;
+    std::function<void(std::shared_ptr<Model>&, const Action&)> reduce;
+    pulse::topic<Snapshot> out;
+
+    std::mutex mx;                 // guards pending, open_tx, flush_posted
+    std::vector<Action> pending;
+    int open_tx{0};
+    bool flush_posted{false};
+
+    std::mutex flush_mx;           // serializes reductions (thread-pool executors)
+    std::vector<Action> batch;     // this and below guarded by flush_mx
+    std::shared_ptr<Model> current;
+    Snapshot published;
+    std::deque<Snapshot> outbox;   // reduced, not yet published
+    bool publishing{false};        // someone is delivering the outbox
+    batch_stats stats;
+  };
+
+  static void enqueue(const std::shared_ptr<state>& st, Action a) {
+    bool post = false;
+    {
+      std::lock_guard<std::mutex> lock(st->mx);
+      st->pending.push_back(std::move(a));
+      if (st->mode == batch_mode::post && !st->open_tx && !st->flush_posted) {
+        st->flush_posted = post = true;
+      }
+    }
+    if (post) st->ex.post([st] { do_flush(st); });
+  }
+
+  // Reduces under flush_mx but publishes without it, so a subscriber may
+  // call current(), flush() or dispatch() (inline executor). Snapshots go
+  // through the outbox so concurrent and nested flushes still emit in order:
+  // whoever finds nobody publishing delivers the outbox until it is empty.
+  static std::size_t do_flush(const std::shared_ptr<state>& st) {
+    std::size_t n;
+    {
+      std::lock_guard<std::mutex> flush_lock(st->flush_mx);
+      n = reduce_pending(*st);
+      if (n == 0 || st->publishing) return n;
+      st->publishing = true;
+    }
+    for (;;) {
+      Snapshot next;
+      {
+        std::lock_guard<std::mutex> flush_lock(st->flush_mx);
+        if (st->outbox.empty()) {
+          st->publishing = false;
+          return n;
+        }
+        next = std::move(st->outbox.front());
+        st->outbox.pop_front();
+      }
+      try {
+        st->out.publish(next);
+      } catch (...) {
+        std::lock_guard<std::mutex> flush_lock(st->flush_mx);
+        st->publishing = false;
+        throw;
+      }
+    }
+  }
+
+  // Folds the pending actions into current; flush_mx held. Returns the batch size.
+  static std::size_t reduce_pending(state& st) {
+    {
+      std::lock_guard<std::mutex> lock(st.mx);
+      st.flush_posted = false;
+      if (st.open_tx) return 0;
+      std::swap(st.batch, st.pending);
+    }
+    const std::size_t n = st.batch.size();
+    if (n == 0) return 0;
+
+    PULSEUI_PROFILE_SCOPE("store.flush");
+    for (const Action& a : st.batch) st.reduce(st.current, a);
+    st.batch.clear();
+
+    batch_stats& s = st.stats;
+    s.actions += n;
+    ++s.batches;
+    s.last_batch = n;
+    s.max_batch  = std::max<std::uint64_t>(s.max_batch, n);
+    ++s.histogram[std::min<std::size_t>(std::bit_width(n) - 1, s.histogram.size() - 1)];
+
+    st.published = st.current;
+    st.outbox.push_back(st.published);
+    return n;
+  }
+
+  std::shared_ptr<state> st_;
+  pulse::subscription sub_;
+};
+
+} // namespace pulseui::core
@@ -0,0 +1,296 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+// Structural-sharing containers for store models. Copying a model made of
+// these copies pointers, and a write clones only the piece it touches, so a
+// reducer working on a fresh snapshot pays for what it changes.
+//
+// Writes reuse a piece in place when use_count() is 1. That is exact only
+// because the shared_ptrs never leave these classes: no weak_ptr to a piece
+// can exist, and a weak_ptr would not show up in use_count().
+
+namespace pulseui::core {
+
+// Copy-on-write box: copies share the value; write() clones it when shared.
+template <class T>
+class cow {
+public:
+  cow() : p_(std::make_shared<T>()) {}
+  cow(T v) : p_(std::make_shared<T>(std::move(v))) {} // NOLINT: implicit like T
+
+  const T& operator*() const { return *p_; }
+  const T* operator->() const { return p_.get(); }
+  const T& get() const { return *p_; }
+
+  T& write() {
+    if (p_.use_count() != 1) {
+      p_ = std::make_shared<T>(std::as_const(*p_));
+    } else {
+      // Pairs with the release in the last other owner's destructor, which
+      // may have run on another thread.
+      std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    return *p_;
+  }
+
+  bool shares_with(const cow& o) const { return p_ == o.p_; }
+
+  friend bool operator==(const cow& a, const cow& b) { return a.p_ == b.p_ || *a.p_ == *b.p_; }
+
+private:
+  std::shared_ptr<T> p_;
+};
+
+// Vector stored as shared chunks of ChunkSize elements. Copy is
+// O(size / ChunkSize) pointer copies; set()/write()/push_back() clone at most
+// one chunk.
+template <class T, std::size_t ChunkSize = 64>
+class shared_vector {
+  using chunk = std::vector<T>;
+
+public:
+  shared_vector() = default;
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const T& operator[](std::size_t i) const { return (*chunks_[i / ChunkSize])[i % ChunkSize]; }
+
+  T& write(std::size_t i) { return own(i / ChunkSize)[i % ChunkSize]; }
+  void set(std::size_t i, T v) { write(i) = std::move(v); }
+
+  void push_back(T v) {
+    if (size_ % ChunkSize == 0) {
+      auto c = std::make_shared<chunk>();
+      c->reserve(ChunkSize);
+      chunks_.push_back(std::move(c));
+    }
+    own(chunks_.size() - 1).push_back(std::move(v));
+    ++size_;
+  }
+
+  void pop_back() {
+    own(chunks_.size() - 1).pop_back();
+    if (--size_ % ChunkSize == 0) chunks_.pop_back();
+  }
+
+  void clear() { chunks_.clear(); size_ = 0; }
+
+  template <class F>
+  void for_each(F&& f) const {
+    for (const auto& c : chunks_) for (const T& v : *c) f(v);
+  }
+
+  friend bool operator==(const shared_vector& a, const shared_vector& b) {
+    if (a.size_ != b.size_) return false;
+    for (std::size_t i = 0; i < a.chunks_.size(); ++i) {
+      if (a.chunks_[i] != b.chunks_[i] && *a.chunks_[i] != *b.chunks_[i]) return false;
+    }
+    return true;
+  }
+
+private:
+  chunk& own(std::size_t ci) {
+    auto& c = chunks_[ci];
+    if (c.use_count() != 1) {
+      auto copy = std::make_shared<chunk>();
+      copy->reserve(ChunkSize);
+      copy->assign(c->begin(), c->end());
+      c = std::move(copy);
+    } else {
+      std::atomic_thread_fence(std::memory_order_acquire); // as in cow::write
+    }
+    return *c;
+  }
+
+  std::vector<std::shared_ptr<chunk>> chunks_;
+  std::size_t size_{0};
+};
+
+// Persistent hash map: a hash array mapped trie (CHAMP layout) of
+// copy-on-write nodes with up to 32 entries each. Copy is one pointer copy;
+// write()/set()/erase() clone only the O(log32 n) nodes on the key's path.
+template <class K, class V, class Hash = std::hash<K>>
+class shared_map {
+  static constexpr unsigned kBits = 5;
+  static constexpr unsigned kHashBits = sizeof(std::size_t) * 8;
+
+  // Below kHashBits a node holds leaves and children, each slot picked by
+  // kBits of the hash; at kHashBits (all bits used) it is a collision node
+  // holding leaves in no particular order.
+  struct node {
+    std::uint32_t datamap{0}, nodemap{0};
+    std::vector<std::pair<K, V>> leaves;
+    std::vector<std::shared_ptr<node>> children;
+  };
+  using node_ptr = std::shared_ptr<node>;
+
+public:
+  shared_map() = default;
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const V* find(const K& k) const {
+    const std::size_t h = Hash{}(k);
+    const node* n = root_.get();
+    for (unsigned shift = 0; n; shift += kBits) {
+      if (shift >= kHashBits) {
+        for (const auto& kv : n->leaves) if (kv.first == k) return &kv.second;
+        return nullptr;
+      }
+      const std::uint32_t bit = bit_of(h, shift);
+      if (n->datamap & bit) {
+        const auto& kv = n->leaves[slot(n->datamap, bit)];
+        return kv.first == k ? &kv.second : nullptr;
+      }
+      if (!(n->nodemap & bit)) return nullptr;
+      n = n->children[slot(n->nodemap, bit)].get();
+    }
+    return nullptr;
+  }
+
+  bool contains(const K& k) const { return find(k) != nullptr; }
+
+  // Inserts a default V if k is missing.
+  V& write(const K& k) {
+    if (!root_) root_ = std::make_shared<node>();
+    return write(root_, k, Hash{}(k), 0);
+  }
+  void set(const K& k, V v) { write(k) = std::move(v); }
+
+  bool erase(const K& k) {
+    if (!find(k)) return false; // nothing to clone
+    erase(root_, k, Hash{}(k), 0);
+    --size_;
+    return true;
+  }
+
+  void clear() { root_.reset(); size_ = 0; }
+
+  template <class F>
+  void for_each(F&& f) const {
+    if (root_) visit(*root_, f);
+  }
+
+  // Shared subtrees compare by pointer, so comparing a snapshot with its
+  // successor only walks the changed paths.
+  friend bool operator==(const shared_map& a, const shared_map& b) {
+    if (a.size_ != b.size_) return false;
+    if (a.root_ == b.root_ || a.size_ == 0) return true;
+    return equal(*a.root_, *b.root_, 0);
+  }
+
+private:
+  static std::uint32_t bit_of(std::size_t h, unsigned shift) { return 1u << ((h >> shift) & 31u); }
+  static std::size_t slot(std::uint32_t map, std::uint32_t bit) { return (std::size_t)std::popcount(map & (bit - 1)); }
+
+  static node& own(node_ptr& n) {
+    if (n.use_count() != 1) {
+      n = std::make_shared<node>(std::as_const(*n));
+    } else {
+      // Pairs with the release in the last other owner's destructor.
+      std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    return *n;
+  }
+
+  V& write(node_ptr& np, const K& k, std::size_t h, unsigned shift) {
+    node& n = own(np);
+    if (shift >= kHashBits) {
+      for (auto& kv : n.leaves) if (kv.first == k) return kv.second;
+      ++size_;
+      return n.leaves.emplace_back(k, V{}).second;
+    }
+    const std::uint32_t bit = bit_of(h, shift);
+    if (n.nodemap & bit) return write(n.children[slot(n.nodemap, bit)], k, h, shift + kBits);
+    if (!(n.datamap & bit)) {
+      ++size_;
+      n.datamap |= bit;
+      return n.leaves.emplace(n.leaves.begin() + (std::ptrdiff_t)slot(n.datamap, bit), k, V{})->second;
+    }
+    const std::size_t li = slot(n.datamap, bit);
+    if (n.leaves[li].first == k) return n.leaves[li].second;
+
+    // Two keys share this slot: push the old leaf down into a new child.
+    std::pair<K, V> old = std::move(n.leaves[li]);
+    n.leaves.erase(n.leaves.begin() + (std::ptrdiff_t)li);
+    n.datamap &= ~bit;
+    n.nodemap |= bit;
+    node_ptr& child = *n.children.emplace(n.children.begin() + (std::ptrdiff_t)slot(n.nodemap, bit),
+                                          std::make_shared<node>());
+    const std::size_t before = size_;
+    write(child, old.first, Hash{}(old.first), shift + kBits) = std::move(old.second);
+    size_ = before;
+    return write(child, k, h, shift + kBits);
+  }
+
+  // k is known to be present. A child left with a single leaf and no
+  // children is folded back into its parent, which keeps the trie canonical
+  // (same contents, same shape) for operator==.
+  void erase(node_ptr& np, const K& k, std::size_t h, unsigned shift) {
+    node& n = own(np);
+    if (shift >= kHashBits) {
+      for (std::size_t i = 0; i < n.leaves.size(); ++i) {
+        if (n.leaves[i].first == k) { n.leaves.erase(n.leaves.begin() + (std::ptrdiff_t)i); break; }
+      }
+      return;
+    }
+    const std::uint32_t bit = bit_of(h, shift);
+    if (n.datamap & bit) {
+      n.leaves.erase(n.leaves.begin() + (std::ptrdiff_t)slot(n.datamap, bit));
+      n.datamap &= ~bit;
+      return;
+    }
+    const std::size_t ci = slot(n.nodemap, bit);
+    erase(n.children[ci], k, h, shift + kBits);
+    node& c = *n.children[ci];
+    if (!c.children.empty() || c.leaves.size() > 1) return;
+    std::optional<std::pair<K, V>> last;
+    if (!c.leaves.empty()) last.emplace(std::move(c.leaves.front())); // c was owned by the erase above
+    n.children.erase(n.children.begin() + (std::ptrdiff_t)ci);
+    n.nodemap &= ~bit;
+    if (last) {
+      n.datamap |= bit;
+      n.leaves.insert(n.leaves.begin() + (std::ptrdiff_t)slot(n.datamap, bit), std::move(*last));
+    }
+  }
+
+  template <class F>
+  static void visit(const node& n, F& f) {
+    for (const auto& [k, v] : n.leaves) f(k, v);
+    for (const auto& c : n.children) visit(*c, f);
+  }
+
+  static bool equal(const node& a, const node& b, unsigned shift) {
+    if (a.datamap != b.datamap || a.nodemap != b.nodemap || a.leaves.size() != b.leaves.size()) return false;
+    if (shift >= kHashBits) { // unordered
+      for (const auto& kv : a.leaves) {
+        bool found = false;
+        for (const auto& other : b.leaves) {
+          if (other.first == kv.first) { found = other.second == kv.second; break; }
+        }
+        if (!found) return false;
+      }
+      return true;
+    }
+    if (a.leaves != b.leaves) return false;
+    for (std::size_t i = 0; i < a.children.size(); ++i) {
+      if (a.children[i] != b.children[i] && !equal(*a.children[i], *b.children[i], shift + kBits)) return false;
+    }
+    return true;
+  }
+
+  node_ptr root_;
+  std::size_t size_{0};
+};
+
+} // namespace pulseui::core
@@ -1,8 +1,22 @@
 #pragma once
 #include <functional>
+#include <type_traits>
+#include <utility>
+#include <pulseui/core/task.hpp>
 namespace pulseui::core {
   struct executor {
     virtual ~executor() = default;
-    virtual void post(std::function<void()> fn) = 0;
+
+    // Implementations override post(task): it takes any callable without
+    // wrapping it in a std::function first. post(std::function) is kept
+    // virtual for callers of the old interface and forwards to it.
+    virtual void post(task t) = 0;
+    virtual void post(std::function<void()> fn) { post(task(std::move(fn))); }
+
+    // Any other void() callable. Small callables are stored inline in the
+    // task, with no extra type-erasure layer or allocation.
+    template <class F, class D = std::decay_t<F>,
+              class = std::enable_if_t<!std::is_same_v<D, task> && !std::is_same_v<D, std::function<void()>>>>
+    void post(F&& fn) { post(task(std::forward<F>(fn))); }
   };
 }
@@ -0,0 +1,94 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+namespace pulseui::core {
+
+struct frame_arena_stats {
+  std::uint64_t frames{};      // reset() calls
+  std::uint64_t chunk_allocs{}; // heap allocations made for chunks
+  std::size_t   used{};        // bytes handed out since the last reset
+  std::size_t   peak{};        // largest `used` seen at a reset
+  std::size_t   capacity{};    // bytes held in chunks
+};
+
+// Monotonic std::pmr::memory_resource for data that lives for one frame.
+// Allocation bumps a pointer, deallocation is a no-op and reset() rewinds to
+// the first chunk while keeping every chunk, so once a frame's peak has been
+// seen, later frames of the same shape never touch the heap. Single-threaded.
+//
+//   std::pmr::vector<Rect> rects(&arena);  // gone at arena.reset()
+class frame_arena final : public std::pmr::memory_resource {
+public:
+  explicit frame_arena(std::size_t first_chunk = std::size_t(16) << 10)
+    : first_chunk_(std::max<std::size_t>(first_chunk, 256)) {}
+
+  frame_arena(const frame_arena&) = delete;
+  frame_arena& operator=(const frame_arena&) = delete;
+
+  // Invalidates everything allocated so far; keeps the chunks.
+  void reset() {
+    stats_.peak = std::max(stats_.peak, stats_.used);
+    stats_.used = 0;
+    ++stats_.frames;
+    current_ = 0;
+    offset_ = 0;
+  }
+
+  // reset() and returns the chunks to the heap.
+  void release() {
+    reset();
+    chunks_.clear();
+    stats_.capacity = 0;
+  }
+
+  const frame_arena_stats& stats() const { return stats_; }
+
+private:
+  struct chunk {
+    std::unique_ptr<std::byte[]> data;
+    std::size_t size;
+  };
+
+  void* do_allocate(std::size_t bytes, std::size_t align) override {
+    bytes = std::max<std::size_t>(bytes, 1);
+    for (; current_ < chunks_.size(); ++current_, offset_ = 0) {
+      if (void* p = bump(chunks_[current_], bytes, align)) return p;
+    }
+    // Chunks double so a growing frame settles after a few of them.
+    const std::size_t last = chunks_.empty() ? first_chunk_ / 2 : chunks_.back().size;
+    const std::size_t size = std::max(last * 2, bytes + align);
+    chunks_.push_back(chunk{std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+    ++stats_.chunk_allocs;
+    stats_.capacity += size;
+    current_ = chunks_.size() - 1;
+    offset_ = 0;
+    return bump(chunks_[current_], bytes, align);
+  }
+
+  void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+  void* bump(chunk& c, std::size_t bytes, std::size_t align) {
+    const auto base = reinterpret_cast<std::uintptr_t>(c.data.get());
+    const std::uintptr_t at = (base + offset_ + (align - 1)) & ~(std::uintptr_t)(align - 1);
+    if (at + bytes > base + c.size) return nullptr;
+    stats_.used += (std::size_t)(at - base) + bytes - offset_;
+    offset_ = (std::size_t)(at - base) + bytes;
+    return reinterpret_cast<void*>(at);
+  }
+
+  std::vector<chunk> chunks_;
+  std::size_t current_{0}; // chunk being bumped
+  std::size_t offset_{0};  // into chunks_[current_]
+  std::size_t first_chunk_;
+  frame_arena_stats stats_;
+};
+
+} // namespace pulseui::core
@@ -0,0 +1,164 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <pulse/pulse.hpp>
+#include <pulseui/core/executor.hpp>
+#include <pulseui/core/profiler.hpp>
+#include <pulseui/core/scheduler.hpp>
+
+namespace pulseui::core {
+
+struct frame_info {
+  std::uint64_t index{};
+  std::chrono::steady_clock::time_point time{};
+  std::chrono::nanoseconds interval{};
+  std::chrono::nanoseconds budget{};
+};
+
+struct frame_stats {
+  std::uint64_t frames{};    // frame callbacks run
+  std::uint64_t requests{};  // request_frame() calls
+  std::uint64_t missed{};    // frames over budget or started late
+  std::uint64_t skipped{};   // whole intervals lost to late ticks
+  std::chrono::nanoseconds last_work{};
+  std::chrono::nanoseconds worst_work{};
+};
+
+// Turns any number of "something changed" signals into at most one frame
+// callback per interval, run on the UI executor. While frames are being
+// requested it ticks on every(); after an idle interval the ticker is
+// dropped, so a quiet UI costs nothing.
+//
+//   core::frame_scheduler frames(*ui_exec);
+//   frames.on_frame([&](const core::frame_info&){ win->invalidate(); });
+//   model$.subscribe([&](const Model& m){ state = m; frames.request_frame(); });
+class frame_scheduler {
+public:
+  using clock    = std::chrono::steady_clock;
+  using FrameCB  = std::function<void(const frame_info&)>;
+  using MissedCB = std::function<void(const frame_info&, std::chrono::nanoseconds work)>;
+
+  explicit frame_scheduler(executor& ui,
+                           std::chrono::nanoseconds interval = std::chrono::nanoseconds(16'666'667))
+    : st_(std::make_shared<state>(ui, interval)) {}
+
+  ~frame_scheduler() {
+    st_->closed = true;
+    if (st_->ticker) st_->ticker.reset();
+  }
+
+  frame_scheduler(const frame_scheduler&) = delete;
+  frame_scheduler& operator=(const frame_scheduler&) = delete;
+
+  // UI thread. Called once per frame with the frame's timing.
+  void on_frame(FrameCB cb) { st_->frame_cb = std::move(cb); }
+  // UI thread. Called after a frame that overran its budget or started late.
+  void on_deadline_missed(MissedCB cb) { st_->missed_cb = std::move(cb); }
+  // UI thread. Work allowed per frame; defaults to the interval.
+  void set_budget(std::chrono::nanoseconds b) { st_->budget = b; }
+
+  // Any thread. Requests between two frames are merged into one; only the
+  // first of them posts to the UI executor.
+  void request_frame() {
+    st_->requests.fetch_add(1, std::memory_order_relaxed);
+    if (st_->pending.exchange(true, std::memory_order_acq_rel)) return;
+    auto st = st_;
+    st->ui.post([st] { kick(st); });
+  }
+
+  // UI thread.
+  frame_stats stats() const {
+    frame_stats s = st_->stats;
+    s.requests = st_->requests.load(std::memory_order_relaxed);
+    return s;
+  }
+
+  std::chrono::nanoseconds interval() const { return st_->interval; }
+  bool ticking() const { return (bool)st_->ticker; }
+
+private:
+  struct state {
+    state(executor& e, std::chrono::nanoseconds i) : ui(e), interval(i), budget(i) {}
+
+    executor& ui;
+    std::chrono::nanoseconds interval;
+    std::chrono::nanoseconds budget;
+    std::atomic<bool> pending{false};
+    std::atomic<std::uint64_t> requests{0};
+
+    // UI thread only
+    FrameCB frame_cb;
+    MissedCB missed_cb;
+    pulse::subscription ticker;
+    clock::time_point last_frame{};
+    int idle_ticks{0};
+    bool closed{false};
+    frame_stats stats;
+  };
+
+  static constexpr int kIdleTicksBeforeStop = 2;
+
+  // First request after an idle period: paint right away, then start ticking
+  // so that the following requests are held until the next interval.
+  static void kick(const std::shared_ptr<state>& st) {
+    if (st->closed || st->ticker) return;
+    const auto now = clock::now();
+    if (now - st->last_frame >= st->interval) run_frame(st, now);
+    st->idle_ticks = 0;
+    std::weak_ptr<state> weak = st;
+    st->ticker = every(st->interval, st->ui).subscribe([weak](auto&&) {
+      if (auto s = weak.lock()) tick(s);
+    });
+  }
+
+  static void tick(const std::shared_ptr<state>& st) {
+    if (st->closed) return;
+    if (!st->pending.load(std::memory_order_acquire)) {
+      if (++st->idle_ticks >= kIdleTicksBeforeStop) st->ticker.reset();
+      return;
+    }
+    st->idle_ticks = 0;
+    run_frame(st, clock::now());
+  }
+
+  static void run_frame(const std::shared_ptr<state>& st, clock::time_point now) {
+    if (!st->pending.exchange(false, std::memory_order_acq_rel)) return;
+    PULSEUI_PROFILE_SCOPE("frame");
+
+    frame_info info;
+    info.index    = st->stats.frames++;
+    info.time     = now;
+    info.interval = st->interval;
+    info.budget   = st->budget;
+
+    // A tick that arrives more than one interval after the previous frame
+    // means whole frames were lost (e.g. to a long task on the UI thread).
+    bool late = false;
+    if (st->last_frame != clock::time_point{} && st->interval.count() > 0) {
+      const auto gap = now - st->last_frame;
+      if (gap >= 2 * st->interval) {
+        late = true;
+        st->stats.skipped += (std::uint64_t)(gap / st->interval) - 1;
+      }
+    }
+    st->last_frame = now;
+
+    if (st->frame_cb) st->frame_cb(info);
+
+    const auto work = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - now);
+    st->stats.last_work = work;
+    if (work > st->stats.worst_work) st->stats.worst_work = work;
+    if (late || work > st->budget) {
+      ++st->stats.missed;
+      if (st->missed_cb) st->missed_cb(info, work);
+    }
+  }
+
+  std::shared_ptr<state> st_;
+};
+
+} // namespace pulseui::core
@@ -0,0 +1,105 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <pulseui/core/executor.hpp>
+#include <pulseui/core/mpsc_queue.hpp>
+#include <pulseui/core/task.hpp>
+
+namespace pulseui::core {
+
+// Portable executor: post() from any thread, run on the one thread that calls
+// run()/run_pending(). Posting is lock-free; the mutex/condvar pair is only
+// touched when the queue goes from idle to busy.
+class loop_executor final : public executor {
+public:
+  loop_executor() = default;
+  ~loop_executor() override {
+    queue_.begin_drain();
+    while (task_node* n = queue_.pop()) delete n;
+  }
+
+  // === core::executor override ===
+  using executor::post;
+  void post(task t) override {
+    if (queue_.push(new task_node(std::move(t)))) wake();
+  }
+
+  // Runs everything posted so far. Returns the number of tasks run.
+  std::size_t run_pending() {
+    queue_.begin_drain();
+    std::size_t n = 0;
+    while (task_node* t = queue_.pop()) {
+      std::unique_ptr<task_node> owned(t);
+      owned->run();
+      ++n;
+    }
+    executed_ += n;
+    return n;
+  }
+
+  // Blocks until something was posted or stop() was called.
+  void wait() {
+    std::unique_lock<std::mutex> lock(mx_);
+    cv_.wait(lock, [&] { return woken_ || stopped_.load(std::memory_order_relaxed); });
+    woken_ = false;
+  }
+
+  // Like wait(), but gives up after d. Returns false on timeout.
+  template <class Rep, class Period>
+  bool wait_for(std::chrono::duration<Rep, Period> d) {
+    std::unique_lock<std::mutex> lock(mx_);
+    const bool ok = cv_.wait_for(lock, d, [&] {
+      return woken_ || stopped_.load(std::memory_order_relaxed);
+    });
+    woken_ = false;
+    return ok;
+  }
+
+  // Runs tasks until stop() is called (from any thread).
+  void run() {
+    while (!stopped_.load(std::memory_order_acquire)) {
+      run_pending();
+      if (stopped_.load(std::memory_order_acquire)) break;
+      wait();
+    }
+    run_pending();
+  }
+
+  // Wakes a wait() without posting anything, e.g. when other work arrived.
+  void notify() { wake(); }
+
+  void stop() {
+    stopped_.store(true, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(mx_);
+    cv_.notify_all();
+  }
+
+  std::uint64_t executed() const { return executed_; }
+  std::uint64_t wakeups() const { return wakeups_.load(std::memory_order_relaxed); }
+
+private:
+  void wake() {
+    wakeups_.fetch_add(1, std::memory_order_relaxed);
+    {
+      std::lock_guard<std::mutex> lock(mx_);
+      woken_ = true;
+    }
+    cv_.notify_one();
+  }
+
+  mpsc_queue<task_node> queue_;
+  std::mutex mx_;
+  std::condition_variable cv_;
+  bool woken_{false}; // guarded by mx_
+  std::atomic<bool> stopped_{false};
+  std::atomic<std::uint64_t> wakeups_{0};
+  std::uint64_t executed_{0}; // consumer thread
+};
+
+} // namespace pulseui::core
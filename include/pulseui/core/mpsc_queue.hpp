@@ -0,0 +1,88 @@
+#pragma once
+#include <atomic>
+#include <type_traits>
+
+namespace pulseui::core {
+
+struct mpsc_node {
+  std::atomic<mpsc_node*> next{nullptr};
+};
+
+// Intrusive lock-free multi-producer/single-consumer queue (Vyukov).
+// T derives from mpsc_node; the queue never allocates or owns nodes.
+//
+// push() also reports whether the consumer has to be woken: only the first
+// push after the consumer called begin_drain() returns true, so a consumer
+// that sleeps between drains gets one wake-up per idle->busy transition
+// instead of one per item.
+//
+// Consumer loop:
+//   q.begin_drain();
+//   while (T* n = q.pop()) { ... }
+//   // sleep until a push() returned true and its producer woke us
+template <class T>
+class mpsc_queue {
+  static_assert(std::is_base_of_v<mpsc_node, T>, "T must derive from mpsc_node");
+
+public:
+  mpsc_queue() = default;
+  mpsc_queue(const mpsc_queue&) = delete;
+  mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+  // Any thread. Returns true if the consumer must be woken.
+  bool push(T* n) {
+    link(n);
+    // The link above is published by this exchange; a consumer that sees
+    // `signaled_ == true` in begin_drain() also sees the node.
+    return !signaled_.exchange(true, std::memory_order_acq_rel);
+  }
+
+  // Consumer thread. Re-arms the wake-up signal; call before popping.
+  void begin_drain() { signaled_.exchange(false, std::memory_order_acq_rel); }
+
+  // Consumer thread. Returns nullptr when empty, or while a producer is
+  // between its two push steps (that producer will signal afterwards).
+  T* pop() {
+    mpsc_node* tail = tail_;
+    mpsc_node* next = tail->next.load(std::memory_order_acquire);
+    if (tail == &stub_) {
+      if (!next) return nullptr;
+      tail_ = next;
+      tail  = next;
+      next  = next->next.load(std::memory_order_acquire);
+    }
+    if (next) {
+      tail_ = next;
+      return static_cast<T*>(tail);
+    }
+    if (tail != head_.load(std::memory_order_acquire)) return nullptr;
+
+    // tail is the last node: put the stub behind it so tail can be handed out.
+    link(&stub_);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next) {
+      tail_ = next;
+      return static_cast<T*>(tail);
+    }
+    return nullptr;
+  }
+
+  // Consumer thread. Approximate: may miss a push in progress.
+  bool empty() const {
+    return tail_ == &stub_ && stub_.next.load(std::memory_order_acquire) == nullptr;
+  }
+
+private:
+  void link(mpsc_node* n) {
+    n->next.store(nullptr, std::memory_order_relaxed);
+    mpsc_node* prev = head_.exchange(n, std::memory_order_acq_rel);
+    prev->next.store(n, std::memory_order_release);
+  }
+
+  mpsc_node stub_;
+  alignas(64) std::atomic<mpsc_node*> head_{&stub_}; // producers
+  alignas(64) std::atomic<bool> signaled_{false};
+  alignas(64) mpsc_node* tail_{&stub_};              // consumer
+};
+
+} // namespace pulseui::core
@@ -0,0 +1,240 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Instrumentation scopes compile to nothing unless PULSEUI_PROFILE is defined
+// (CMake: -DPULSEUI_PROFILE=ON). The profiler API itself is always there.
+//
+//   void paint(Canvas& g) { PULSEUI_PROFILE_SCOPE("paint"); ... }
+//
+//   auto events = core::profiler::collect();
+//   for (auto& s : core::profiler::summarize(events)) ...  // p50/p99 per scope
+//   core::profiler::write_chrome_trace(file, events);     // chrome://tracing, Perfetto
+#define PULSEUI_PROFILE_CAT2(a, b) a##b
+#define PULSEUI_PROFILE_CAT(a, b) PULSEUI_PROFILE_CAT2(a, b)
+
+#if defined(PULSEUI_PROFILE) && PULSEUI_PROFILE
+  // name must be a string literal (or otherwise live forever).
+  #define PULSEUI_PROFILE_SCOPE(name) \
+    ::pulseui::core::profile_scope PULSEUI_PROFILE_CAT(pulseui_profile_scope_, __LINE__)(name)
+  // Records an interval that started at start_ns (profiler::now_ns()) and ends now.
+  #define PULSEUI_PROFILE_SINCE(name, start_ns) \
+    ::pulseui::core::profiler::record_since(name, start_ns)
+  #define PULSEUI_PROFILE_NOW() ::pulseui::core::profiler::now_ns()
+#else
+  #define PULSEUI_PROFILE_SCOPE(name) ((void)0)
+  #define PULSEUI_PROFILE_SINCE(name, start_ns) ((void)0)
+  #define PULSEUI_PROFILE_NOW() std::uint64_t{0}
+#endif
+
+namespace pulseui::core {
+
+struct profile_event {
+  const char* name;
+  std::uint64_t start_ns;
+  std::uint64_t dur_ns;
+  std::uint32_t tid;
+};
+
+struct profile_stats {
+  std::string_view name;
+  std::uint64_t count{};
+  std::uint64_t total_ns{};
+  std::uint64_t p50_ns{};
+  std::uint64_t p99_ns{};
+  std::uint64_t max_ns{};
+};
+
+// Process-wide recorder. Every thread writes into its own ring buffer (one
+// relaxed store per field and a release store of the head, no locks, no
+// allocation after the first event); collect() drains all rings. A ring
+// that is not drained in time overwrites its oldest events (see dropped()).
+class profiler {
+public:
+  static constexpr std::size_t kRingSize = 8192; // events per thread
+
+  static std::uint64_t now_ns() {
+    return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  // Runtime switch on top of the compile-time one.
+  static void set_enabled(bool on) { state().enabled.store(on, std::memory_order_relaxed); }
+  static bool enabled() { return state().enabled.load(std::memory_order_relaxed); }
+
+  static void record(const char* name, std::uint64_t start_ns, std::uint64_t dur_ns) {
+    if (!enabled()) return;
+    ring& r = local();
+    const std::uint64_t h = r.head.load(std::memory_order_relaxed);
+    // Orders the head stores so far before the slot stores below: a
+    // collector that reads any of them then sees head >= h (see collect()).
+    std::atomic_thread_fence(std::memory_order_release);
+    slot& s = r.slots[h % kRingSize];
+    s.name.store(name, std::memory_order_relaxed);
+    s.start.store(start_ns, std::memory_order_relaxed);
+    s.dur.store(dur_ns, std::memory_order_relaxed);
+    r.head.store(h + 1, std::memory_order_release);
+  }
+
+  static void record_since(const char* name, std::uint64_t start_ns) {
+    if (start_ns == 0) return;
+    const std::uint64_t now = now_ns();
+    record(name, start_ns, now > start_ns ? now - start_ns : 0);
+  }
+
+  // Events recorded since the previous collect(), oldest first per thread.
+  static std::vector<profile_event> collect() {
+    std::vector<profile_event> out;
+    shared& st = state();
+    std::lock_guard<std::mutex> lock(st.mx);
+    for (const auto& r : st.rings) {
+      const std::uint64_t head = r->head.load(std::memory_order_acquire);
+      std::uint64_t from = std::max(r->tail, head > kRingSize ? head - kRingSize : 0);
+      st.dropped += from - r->tail;
+      const std::size_t first = out.size();
+      for (std::uint64_t i = from; i < head; ++i) {
+        const slot& s = r->slots[i % kRingSize];
+        out.push_back(profile_event{s.name.load(std::memory_order_relaxed), s.start.load(std::memory_order_relaxed),
+                                    s.dur.load(std::memory_order_relaxed), r->tid});
+      }
+      // The owner may have lapped us while copying: drop what it overwrote,
+      // including the slot of event `after`, which it may be writing now.
+      std::atomic_thread_fence(std::memory_order_acquire);
+      const std::uint64_t after = r->head.load(std::memory_order_relaxed);
+      if (after + 1 > kRingSize && after + 1 - kRingSize > from) {
+        const std::uint64_t lost = std::min(after + 1 - kRingSize, head) - from;
+        out.erase(out.begin() + (std::ptrdiff_t)first, out.begin() + (std::ptrdiff_t)(first + lost));
+        st.dropped += lost;
+      }
+      r->tail = head;
+    }
+    return out;
+  }
+
+  // Events lost to ring overflow so far.
+  static std::uint64_t dropped() {
+    std::lock_guard<std::mutex> lock(state().mx);
+    return state().dropped;
+  }
+
+  // Per-name count, total, p50, p99 and max, sorted by total time.
+  static std::vector<profile_stats> summarize(std::span<const profile_event> events) {
+    std::vector<profile_stats> out;
+    std::vector<std::uint64_t> durs;
+    std::vector<std::string_view> names;
+    for (const profile_event& e : events) {
+      if (std::find(names.begin(), names.end(), std::string_view(e.name)) == names.end()) names.push_back(e.name);
+    }
+    for (std::string_view n : names) {
+      durs.clear();
+      profile_stats s;
+      s.name = n;
+      for (const profile_event& e : events) {
+        if (n != e.name) continue;
+        durs.push_back(e.dur_ns);
+        s.total_ns += e.dur_ns;
+        s.max_ns = std::max(s.max_ns, e.dur_ns);
+      }
+      s.count = durs.size();
+      s.p50_ns = percentile(durs, 0.50);
+      s.p99_ns = percentile(durs, 0.99);
+      out.push_back(s);
+    }
+    std::sort(out.begin(), out.end(), [](const profile_stats& a, const profile_stats& b) { return a.total_ns > b.total_ns; });
+    return out;
+  }
+
+  // Chrome trace-event JSON ("X" complete events, microseconds).
+  static void write_chrome_trace(std::ostream& os, std::span<const profile_event> events) {
+    std::uint64_t t0 = ~std::uint64_t{0};
+    for (const profile_event& e : events) t0 = std::min(t0, e.start_ns);
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    for (const profile_event& e : events) {
+      if (!first) os << ',';
+      first = false;
+      os << "\n{\"name\":\"";
+      for (const char* c = e.name; *c; ++c) {
+        if (*c == '"' || *c == '\\') os << '\\';
+        os << *c;
+      }
+      os << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.tid
+         << ",\"ts\":" << (double)(e.start_ns - t0) / 1000.0
+         << ",\"dur\":" << (double)e.dur_ns / 1000.0 << '}';
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  }
+
+private:
+  struct slot {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<std::uint64_t> start{0};
+    std::atomic<std::uint64_t> dur{0};
+  };
+
+  struct ring {
+    std::array<slot, kRingSize> slots;
+    std::atomic<std::uint64_t> head{0}; // owner thread
+    std::uint64_t tail{0};              // collector, under shared::mx
+    std::uint32_t tid{0};
+  };
+
+  struct shared {
+    std::atomic<bool> enabled{true};
+    std::mutex mx;
+    std::vector<std::shared_ptr<ring>> rings; // kept after their thread exits
+    std::uint32_t next_tid{1};
+    std::uint64_t dropped{0};
+  };
+
+  static shared& state() {
+    static shared s;
+    return s;
+  }
+
+  // Registers the calling thread's ring on first use.
+  static ring& local() {
+    thread_local std::shared_ptr<ring> r = [] {
+      auto created = std::make_shared<ring>();
+      shared& st = state();
+      std::lock_guard<std::mutex> lock(st.mx);
+      created->tid = st.next_tid++;
+      st.rings.push_back(created);
+      return created;
+    }();
+    return *r;
+  }
+
+  static std::uint64_t percentile(std::vector<std::uint64_t>& v, double q) {
+    if (v.empty()) return 0;
+    const auto k = (std::size_t)(q * (double)(v.size() - 1) + 0.5);
+    std::nth_element(v.begin(), v.begin() + (std::ptrdiff_t)k, v.end());
+    return v[k];
+  }
+};
+
+// Times its own lifetime; use through PULSEUI_PROFILE_SCOPE.
+class profile_scope {
+public:
+  explicit profile_scope(const char* name) : name_(name), start_(profiler::now_ns()) {}
+  ~profile_scope() { profiler::record(name_, start_, profiler::now_ns() - start_); }
+
+  profile_scope(const profile_scope&) = delete;
+  profile_scope& operator=(const profile_scope&) = delete;
+
+private:
+  const char* name_;
+  std::uint64_t start_;
+};
+
+} // namespace pulseui::core
@@ -10,7 +10,7 @@ namespace pulseui::core {
     pulseui::core::executor& ex_;
   public:
     explicit pulse_executor_adapter(pulseui::core::executor& ex) : ex_(ex) {}
-    void post(std::function<void()> fn) override { ex_.post(std::move(fn)); }
+    void post(std::function<void()> fn) override { ex_.post(task(std::move(fn))); }
   };
 
   inline pulse_executor_adapter as_pulse_executor(pulseui::core::executor& ex) {
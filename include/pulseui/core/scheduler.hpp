@@ -1,12 +1,28 @@
 #pragma once
 #include <chrono>
+#include <functional>
+#include <utility>
 #include <pulse/pulse.hpp>
 #include <pulseui/core/executor.hpp>
 #include <pulseui/core/reactive.hpp>
+#include <pulseui/core/timer_service.hpp>
 
 namespace pulseui::core {
+  // One pulse::interval (and its own timer) per call; prefer the
+  // timer_service overloads when a UI has many timers.
   template<class Rep, class Period>
   inline auto every(std::chrono::duration<Rep,Period> d, executor& ex) {
     return pulse::interval(d, as_pulse_executor(ex));
   }
+
+  // Shares the service's timing wheel; the timer lives as long as the handle.
+  template<class Rep, class Period>
+  inline scoped_timer every(std::chrono::duration<Rep,Period> d, timer_service& ts, std::function<void()> fn) {
+    return scoped_timer(ts, ts.every(std::chrono::duration_cast<std::chrono::nanoseconds>(d), std::move(fn)));
+  }
+
+  template<class Rep, class Period>
+  inline scoped_timer after(std::chrono::duration<Rep,Period> d, timer_service& ts, std::function<void()> fn) {
+    return scoped_timer(ts, ts.after(std::chrono::duration_cast<std::chrono::nanoseconds>(d), std::move(fn)));
+  }
 }
@@ -0,0 +1,113 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <pulse/pulse.hpp>
+
+namespace pulseui::core {
+
+struct selector_stats {
+  std::uint64_t calls{};      // evaluations requested
+  std::uint64_t recomputes{}; // evaluations that ran the combiner
+};
+
+// Reselect-style memoized selector over Model: a combiner applied to the
+// results of input projections (member pointers, lambdas or other
+// memo_selectors). The selector keeps a copy of the last input results and
+// compares new ones to it with operator==; the combiner only runs when one
+// differs. With cow/shared_vector/shared_map fields both the copy and the
+// comparison of unchanged data come down to pointers.
+template <class Model, class Combiner, class... Inputs>
+class memo_selector {
+  template <class In>
+  using result_t = std::invoke_result_t<In&, const Model&>; // may be a reference
+
+  using Results = std::tuple<result_t<Inputs>...>;
+  using Cached  = std::tuple<std::decay_t<result_t<Inputs>>...>;
+  using Out     = std::decay_t<std::invoke_result_t<Combiner&, const std::decay_t<result_t<Inputs>>&...>>;
+
+public:
+  memo_selector(Combiner c, Inputs... in) : combine_(std::move(c)), inputs_(std::move(in)...) {}
+
+  const Out& operator()(const Model& m) {
+    ++stats_.calls;
+    return eval(m, std::index_sequence_for<Inputs...>{});
+  }
+
+  const selector_stats& stats() const { return stats_; }
+
+private:
+  template <std::size_t... I>
+  const Out& eval(const Model& m, std::index_sequence<I...>) {
+    // Member pointers yield references into the model; results are copied
+    // into the cache only when they changed.
+    Results now{std::invoke(std::get<I>(inputs_), m)...};
+    if (!in_ || !(*in_ == now)) {
+      in_.emplace(std::get<I>(now)...);
+      out_.emplace(std::invoke(combine_, std::get<I>(*in_)...));
+      ++stats_.recomputes;
+    }
+    return *out_;
+  }
+
+  Combiner combine_;
+  std::tuple<Inputs...> inputs_;
+  std::optional<Cached> in_;
+  std::optional<Out> out_;
+  selector_stats stats_;
+};
+
+namespace detail {
+  template <class Model, class Tuple, std::size_t... I>
+  auto make_memo(Tuple&& t, std::index_sequence<I...>) {
+    constexpr std::size_t N = std::tuple_size_v<std::decay_t<Tuple>>;
+    using C = std::tuple_element_t<N - 1, std::decay_t<Tuple>>;
+    return memo_selector<Model, C, std::tuple_element_t<I, std::decay_t<Tuple>>...>(
+      std::get<N - 1>(std::forward<Tuple>(t)), std::get<I>(std::forward<Tuple>(t))...);
+  }
+
+  template <class T> struct is_shared_ptr : std::false_type {};
+  template <class T> struct is_shared_ptr<std::shared_ptr<T>> : std::true_type {};
+
+  template <class T>
+  const auto& deref(const T& v) {
+    if constexpr (is_shared_ptr<T>::value) return *v;
+    else return v;
+  }
+} // namespace detail
+
+// make_selector<Model>(input..., combiner):
+//   auto visible = make_selector<Model>(&Model::rows, &Model::filter,
+//                    [](const Rows& r, const Filter& f){ return apply(r, f); });
+// Selectors compose: a memo_selector is a valid input of another one.
+template <class Model, class... Args>
+auto make_selector(Args... args) {
+  static_assert(sizeof...(Args) >= 2, "make_selector needs at least one input and a combiner");
+  return detail::make_memo<Model>(std::tuple<Args...>(std::move(args)...),
+                           std::make_index_sequence<sizeof...(Args) - 1>{});
+}
+
+// Derived stream over a store: runs the projection (member pointer, lambda or
+// memo_selector) per model and emits only when the derived value changes.
+// Snapshots of make_shared_store are not held between models: holding one
+// would force the store to copy the model on every action. That also rules
+// out recognizing a repeated snapshot by pointer, since an unshared snapshot
+// is updated in place.
+template <class T, class Projection>
+auto select(pulse::observable<T> models, Projection projection) {
+  using Model = std::decay_t<decltype(detail::deref(std::declval<const T&>()))>;
+  using Out   = std::decay_t<std::invoke_result_t<Projection&, const Model&>>;
+
+  return models
+    | pulse::map([proj = std::move(projection)](const T& v) mutable -> Out {
+        return std::invoke(proj, detail::deref(v));
+      })
+    | pulse::distinct_until_changed();
+}
+
+} // namespace pulseui::core
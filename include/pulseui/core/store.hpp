@@ -1,7 +1,10 @@
 #pragma once
+#include <atomic>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <pulse/pulse.hpp>
+#include <pulseui/core/profiler.hpp>
 
 namespace pulseui::core {
 
@@ -11,11 +14,61 @@ template <class Model, class Action, class Reducer>
 auto make_store(pulse::observable<Action> actions, Reducer reducer) {
   auto state = std::make_shared<Model>(); // initial state Model{}
   return actions | pulse::map([state, reducer](const Action& a) {
-    // Update the accumulated state and send a copy outside
-    *state = reducer(*state, a);
+    // Hand the state over to the reducer instead of copying it in,
+    // then send a copy outside
+    PULSEUI_PROFILE_SCOPE("store.reduce");
+    *state = reducer(std::move(*state), a);
     return *state;
   });
 }
 
-} // namespace pulseui::core
+namespace detail {
+
+// One reduction step on a snapshot slot: in place when nobody else holds the
+// current snapshot, on a fresh copy otherwise. use_count() does not count
+// weak_ptrs, hence the rule against weak references in make_shared_store.
+template <class Model, class Action, class Reducer>
+void reduce_snapshot(std::shared_ptr<Model>& cur, Reducer& reducer, const Action& a) {
+  PULSEUI_PROFILE_SCOPE("store.reduce");
+  const bool unique = cur.use_count() == 1;
+  // Pairs with the release in the last reader's shared_ptr destructor.
+  if (unique) std::atomic_thread_fence(std::memory_order_acquire);
+
+  if constexpr (std::is_void_v<std::invoke_result_t<Reducer&, Model&, const Action&>>) {
+    if (!unique) cur = std::make_shared<Model>(std::as_const(*cur));
+    reducer(*cur, a);
+  } else if (unique) {
+    *cur = reducer(std::move(*cur), a);
+  } else {
+    cur = std::make_shared<Model>(reducer(std::as_const(*cur), a));
+  }
+}
+
+} // namespace detail
 
+// Store emitting immutable snapshots (std::shared_ptr<const Model>) instead of
+// Model copies. The reducer is either
+//   void(Model&, const Action&)   - mutates the state in place, or
+//   Model(const Model&, Action)   - classic pure reducer.
+// A mutating reducer works on the current snapshot directly when nobody else
+// holds it, and on a copy otherwise (copy-on-write), so emitted snapshots never
+// change. Subscribers that keep snapshots around still force that copy; use
+// cow<T>/shared_vector<T>/shared_map<K,V> (core/cow.hpp) for big fields to
+// make it O(change) rather than O(model).
+//
+// Hold snapshots by shared_ptr only, never by std::weak_ptr. A snapshot whose
+// last shared owner let go is updated in place by the next action, and a
+// weak_ptr locked during that update would see a half-written model. Code
+// that wants to keep "the latest state if still around" keeps a shared_ptr
+// and pays for the copy-on-write.
+template <class Model, class Action, class Reducer>
+auto make_shared_store(pulse::observable<Action> actions, Reducer reducer, Model initial = Model{}) {
+  using Snapshot = std::shared_ptr<const Model>;
+  auto state = std::make_shared<std::shared_ptr<Model>>(std::make_shared<Model>(std::move(initial)));
+  return actions | pulse::map([state, reducer](const Action& a) mutable -> Snapshot {
+    detail::reduce_snapshot(*state, reducer, a);
+    return *state;
+  });
+}
+
+} // namespace pulseui::core
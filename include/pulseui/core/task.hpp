@@ -0,0 +1,214 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <pulseui/core/mpsc_queue.hpp>
+#include <pulseui/core/profiler.hpp>
+
+namespace pulseui::core {
+
+namespace detail {
+
+// Process-wide pool of fixed-size blocks. Freed blocks go onto a shared
+// lock-free stack; an allocating thread takes the whole stack at once into a
+// thread-local cache, so there is no per-block pop (and no ABA problem).
+// Blocks are recycled, never returned to the system allocator.
+template <std::size_t BlockSize>
+class block_pool {
+  struct free_block { free_block* next; };
+  static_assert(BlockSize >= sizeof(free_block));
+
+  struct local_cache {
+    free_block* head = nullptr;
+    ~local_cache() {
+      while (head) {
+        free_block* next = head->next;
+        deallocate(head);
+        head = next;
+      }
+    }
+  };
+
+  static std::atomic<free_block*>& shared() {
+    static std::atomic<free_block*> s{nullptr};
+    return s;
+  }
+
+  static local_cache& local() {
+    thread_local local_cache c;
+    return c;
+  }
+
+public:
+  static constexpr std::size_t block_size = BlockSize;
+
+  static void* allocate() {
+    local_cache& c = local();
+    if (!c.head) c.head = shared().exchange(nullptr, std::memory_order_acquire);
+    if (free_block* b = c.head) {
+      c.head = b->next;
+      return b;
+    }
+    return ::operator new(BlockSize);
+  }
+
+  static void deallocate(void* p) noexcept {
+    auto* b = static_cast<free_block*>(p);
+    std::atomic<free_block*>& s = shared();
+    b->next = s.load(std::memory_order_relaxed);
+    while (!s.compare_exchange_weak(b->next, b, std::memory_order_release,
+                                    std::memory_order_relaxed)) {
+    }
+  }
+};
+
+template <class F>
+struct is_std_function : std::false_type {};
+template <class R, class... A>
+struct is_std_function<std::function<R(A...)>> : std::true_type {};
+
+} // namespace detail
+
+// Move-only void() callable with inline storage. Callables up to
+// inline_size bytes (which covers std::function and typical lambdas
+// capturing a few pointers and values) are stored in place; larger ones go to
+// a pooled block, and only captures beyond pooled_size hit operator new.
+// An empty std::function or a null function pointer makes an empty task.
+class task {
+public:
+  static constexpr std::size_t inline_size = 56;
+  static constexpr std::size_t pooled_size = 256;
+
+  task() noexcept = default;
+
+  template <class F,
+            class D = std::decay_t<F>,
+            class = std::enable_if_t<!std::is_same_v<D, task> && std::is_invocable_v<D&>>>
+  task(F&& f) { // NOLINT: implicit on purpose, post([..]{...}) must just work
+    if constexpr (std::is_pointer_v<D> || detail::is_std_function<D>::value) {
+      if (!f) return; // empty std::function or null pointer: empty task
+    }
+    if constexpr (fits_inline<D>()) {
+      ::new (static_cast<void*>(buf_)) D(std::forward<F>(f));
+      ops_ = &inline_ops<D>;
+    } else {
+      void* mem = sizeof(D) <= pooled_size && alignof(D) <= alignof(std::max_align_t)
+                    ? detail::block_pool<pooled_size>::allocate()
+                    : ::operator new(sizeof(D), std::align_val_t{alignof(D)});
+      try {
+        ::new (mem) D(std::forward<F>(f));
+      } catch (...) {
+        release<D>(mem);
+        throw;
+      }
+      *reinterpret_cast<void**>(buf_) = mem;
+      ops_ = &heap_ops<D>;
+    }
+  }
+
+  task(task&& o) noexcept : ops_(o.ops_) {
+    if (ops_) {
+      ops_->move(buf_, o.buf_);
+      o.ops_ = nullptr;
+    }
+  }
+
+  task& operator=(task&& o) noexcept {
+    if (this != &o) {
+      reset();
+      if (o.ops_) {
+        o.ops_->move(buf_, o.buf_);
+        ops_ = o.ops_;
+        o.ops_ = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  task(const task&) = delete;
+  task& operator=(const task&) = delete;
+
+  ~task() { reset(); }
+
+  void operator()() { ops_->invoke(buf_); }
+  explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+  void reset() noexcept {
+    if (ops_) {
+      ops_->destroy(buf_);
+      ops_ = nullptr;
+    }
+  }
+
+  template <class D>
+  static constexpr bool fits_inline() {
+    return sizeof(D) <= inline_size && alignof(D) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible_v<D>;
+  }
+
+private:
+  struct ops_table {
+    void (*invoke)(void*);
+    void (*move)(void* dst, void* src) noexcept;
+    void (*destroy)(void*) noexcept;
+  };
+
+  template <class D>
+  static void release(void* mem) noexcept {
+    if constexpr (sizeof(D) <= pooled_size && alignof(D) <= alignof(std::max_align_t)) {
+      detail::block_pool<pooled_size>::deallocate(mem);
+    } else {
+      ::operator delete(mem, std::align_val_t{alignof(D)});
+    }
+  }
+
+  template <class D>
+  static constexpr ops_table inline_ops{
+    [](void* p) { (*static_cast<D*>(p))(); },
+    [](void* dst, void* src) noexcept {
+      ::new (dst) D(std::move(*static_cast<D*>(src)));
+      static_cast<D*>(src)->~D();
+    },
+    [](void* p) noexcept { static_cast<D*>(p)->~D(); },
+  };
+
+  template <class D>
+  static constexpr ops_table heap_ops{
+    [](void* p) { (**static_cast<D**>(p))(); },
+    [](void* dst, void* src) noexcept { *static_cast<void**>(dst) = *static_cast<void**>(src); },
+    [](void* p) noexcept {
+      D* obj = *static_cast<D**>(p);
+      obj->~D();
+      release<D>(obj);
+    },
+  };
+
+  alignas(std::max_align_t) unsigned char buf_[inline_size];
+  const ops_table* ops_{nullptr};
+};
+
+// Queue node carrying a task; nodes come from a block pool, so a steady
+// stream of posts does not touch the system allocator.
+struct task_node : mpsc_node {
+  explicit task_node(task t) noexcept : fn(std::move(t)) {}
+  task fn;
+#if defined(PULSEUI_PROFILE) && PULSEUI_PROFILE
+  std::uint64_t posted_ns{profiler::now_ns()};
+#endif
+
+  // Runs fn; profiled builds also record the time it spent queued.
+  void run() {
+    PULSEUI_PROFILE_SINCE("task.wait", posted_ns);
+    PULSEUI_PROFILE_SCOPE("task");
+    if (fn) fn();
+  }
+
+  static void* operator new(std::size_t) { return detail::block_pool<sizeof(task_node)>::allocate(); }
+  static void operator delete(void* p) noexcept { detail::block_pool<sizeof(task_node)>::deallocate(p); }
+};
+
+} // namespace pulseui::core
@@ -0,0 +1,462 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <pulseui/core/executor.hpp>
+#include <pulseui/core/profiler.hpp>
+
+namespace pulseui::core {
+
+// === Clocks ===
+// Monotonic time source for timer_service, in nanoseconds from an arbitrary epoch.
+class timer_clock {
+public:
+  virtual ~timer_clock() = default;
+  virtual std::chrono::nanoseconds now() const = 0;
+};
+
+class steady_timer_clock final : public timer_clock {
+public:
+  std::chrono::nanoseconds now() const override {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch());
+  }
+
+  static steady_timer_clock& instance() {
+    static steady_timer_clock c;
+    return c;
+  }
+};
+
+// Clock that only moves when told to, for deterministic tests. A
+// timer_service on a manual clock has no driver thread: advance the clock,
+// then call poll().
+class manual_clock final : public timer_clock {
+public:
+  std::chrono::nanoseconds now() const override { return std::chrono::nanoseconds(ns_.load(std::memory_order_acquire)); }
+  void advance(std::chrono::nanoseconds d) { ns_.fetch_add(d.count(), std::memory_order_acq_rel); }
+  void set(std::chrono::nanoseconds t) { ns_.store(t.count(), std::memory_order_release); }
+
+private:
+  std::atomic<std::int64_t> ns_{0};
+};
+
+// === Timer service ===
+struct timer_id {
+  std::uint32_t index{std::numeric_limits<std::uint32_t>::max()};
+  std::uint32_t gen{0};
+  explicit operator bool() const { return index != std::numeric_limits<std::uint32_t>::max(); }
+};
+
+struct timer_stats {
+  std::uint64_t active{};
+  std::uint64_t fired{};
+  std::uint64_t cancelled{};
+  std::uint64_t cascaded{};  // entries moved down a wheel level
+  std::uint64_t missed{};    // periods skipped: a late tick, or due while still running
+  std::uint64_t batches{};   // polls that fired something
+};
+
+// All timers of a UI in one hierarchical timing wheel: 5 levels of 64 slots
+// over `resolution` ticks (about 34 years at 1ms). Insert and cancel are O(1);
+// advancing jumps straight to the next occupied slot using per-level
+// occupancy bitmaps, so idle time and far-away timers cost nothing per tick.
+// Everything that expires by a poll() is fired in one batch on the UI thread.
+//
+//   core::timer_service timers(*ui_exec);
+//   auto blink = timers.every(500ms, [&]{ caret_on = !caret_on; win->invalidate(caret); });
+//   auto t = timers.after(2s, [&]{ hide_tooltip(); });
+//   timers.cancel(t);
+//
+// With the default clock a driver thread posts a poll() to the UI executor
+// when the next timer is due. All members are UI-thread only, and callbacks
+// may add or cancel timers (a timer cancelled by an earlier callback of the
+// same batch does not fire).
+class timer_service {
+public:
+  using duration   = std::chrono::nanoseconds;
+  using time_point = std::chrono::nanoseconds; // timer_clock time
+  using callback   = std::function<void()>;
+
+  explicit timer_service(executor& ui, duration resolution = std::chrono::milliseconds(1))
+    : timer_service(ui, steady_timer_clock::instance(), resolution, true) {}
+
+  // Manual time: nothing fires until poll().
+  timer_service(executor& ui, manual_clock& clock, duration resolution = std::chrono::milliseconds(1))
+    : timer_service(ui, clock, resolution, false) {}
+
+  ~timer_service() {
+    if (driver_) {
+      {
+        std::lock_guard<std::mutex> lock(driver_->mx);
+        driver_->stopping = true;
+        driver_->alive = false;
+      }
+      driver_->cv.notify_one();
+      driver_->thread.join();
+    }
+  }
+
+  timer_service(const timer_service&) = delete;
+  timer_service& operator=(const timer_service&) = delete;
+
+  // Runs fn once, d from now.
+  timer_id after(duration d, callback fn) { return add(clock_.now() + d, duration::zero(), std::move(fn)); }
+  // Runs fn once at clock time t (already past: on the next poll).
+  timer_id at(time_point t, callback fn) { return add(t, duration::zero(), std::move(fn)); }
+  // Runs fn every period, first one period from now. Late polls skip the
+  // missed periods instead of firing them back to back.
+  timer_id every(duration period, callback fn) {
+    const duration p = std::max(period, resolution_);
+    return add(clock_.now() + p, p, std::move(fn));
+  }
+
+  // Returns false if the timer already fired (one-shot) or was cancelled.
+  bool cancel(timer_id id) {
+    if (!alive(id)) return false;
+    entry& e = entries_[id.index];
+    if (e.state == armed) unlink(id.index);
+    release(id.index);
+    ++stats_.cancelled;
+    rearm_driver();
+    return true;
+  }
+
+  bool active(timer_id id) const { return alive(id) && entries_[id.index].state == armed; }
+
+  // Fires everything due by clock.now(). Returns the number of callbacks run.
+  std::size_t poll() {
+    PULSEUI_PROFILE_SCOPE("timers.poll");
+    // A callback may poll again; it then runs what its own advance queued.
+    const std::size_t first = fire_.size();
+    advance(to_tick(clock_.now()));
+    std::size_t fired = 0;
+    for (std::size_t k = first; k < fire_.size(); ++k) {
+      const timer_id id = fire_[k];
+      if (!alive(id)) continue; // cancelled by an earlier callback
+      // A periodic timer that came due again inside its own callback (which
+      // polled): its fn is out in the outer poll's local. Skip this period.
+      if (!entries_[id.index].fn) {
+        ++stats_.missed;
+        continue;
+      }
+      // Run from a local: the callback may add timers (moving entries_) or
+      // cancel its own.
+      callback fn = std::move(entries_[id.index].fn);
+      if (entries_[id.index].state == firing) release(id.index);
+      fn();
+      if (alive(id)) entries_[id.index].fn = std::move(fn); // periodic, still armed
+      ++fired;
+    }
+    fire_.resize(first);
+    stats_.fired += fired;
+    if (fired) ++stats_.batches;
+    rearm_driver();
+    return fired;
+  }
+
+  // Clock time of the next expiry, or duration::max() with no timers.
+  time_point next_deadline() const {
+    const std::uint64_t t = next_event();
+    return t == kNever ? duration::max() : duration((std::int64_t)t * resolution_.count());
+  }
+
+  std::size_t size() const { return (std::size_t)stats_.active; }
+  duration resolution() const { return resolution_; }
+  const timer_clock& clock() const { return clock_; }
+  executor& ui() { return ui_; }
+  timer_stats stats() const { return stats_; }
+
+private:
+  static constexpr int kLevels = 5;
+  static constexpr int kBits   = 6;
+  static constexpr int kSlots  = 1 << kBits;
+  static constexpr std::uint32_t kNil = std::numeric_limits<std::uint32_t>::max();
+  static constexpr std::uint64_t kNever = std::numeric_limits<std::uint64_t>::max();
+  static constexpr std::uint64_t kReach = std::uint64_t{1} << (kBits * kLevels);
+
+  enum state_t : std::uint8_t { free_slot, armed, firing };
+
+  struct entry {
+    callback fn;
+    std::uint64_t deadline{}; // tick
+    std::uint64_t period{};   // ticks, 0: one-shot
+    std::uint32_t prev{kNil}, next{kNil};
+    std::uint32_t gen{0};
+    std::uint8_t level{}, slot{};
+    state_t state{free_slot};
+  };
+
+  // Wakes the UI executor when the earliest timer is due.
+  struct driver {
+    std::mutex mx;
+    std::condition_variable cv;
+    std::int64_t wake_ns{std::numeric_limits<std::int64_t>::max()}; // guarded by mx
+    bool posted{false};                                              // guarded by mx
+    bool stopping{false};                                            // guarded by mx
+    bool alive{true};                                                // guarded by mx, false once the service is gone
+    std::thread thread;
+  };
+
+  timer_service(executor& ui, timer_clock& clock, duration resolution, bool drive)
+    : ui_(ui), clock_(clock), resolution_(std::max(resolution, duration(1))) {
+    now_tick_ = to_tick(clock_.now());
+    for (auto& level : heads_) level.fill(kNil);
+    if (drive) start_driver();
+  }
+
+  std::uint64_t to_tick(time_point t) const {
+    return t.count() <= 0 ? 0 : (std::uint64_t)(t.count() / resolution_.count());
+  }
+
+  bool alive(timer_id id) const {
+    return id && id.index < entries_.size() && entries_[id.index].gen == id.gen &&
+           entries_[id.index].state != free_slot;
+  }
+
+  timer_id add(time_point t, duration period, callback fn) {
+    std::uint32_t i;
+    if (!free_.empty()) {
+      i = free_.back();
+      free_.pop_back();
+    } else {
+      i = (std::uint32_t)entries_.size();
+      entries_.emplace_back();
+    }
+    entry& e = entries_[i];
+    e.fn       = std::move(fn);
+    // Round up so a timer never fires early.
+    e.deadline = std::max(now_tick_ + 1, (std::uint64_t)((std::max<std::int64_t>(t.count(), 0) + resolution_.count() - 1) / resolution_.count()));
+    e.period   = period.count() > 0 ? (std::uint64_t)((period.count() + resolution_.count() - 1) / resolution_.count()) : 0;
+    e.state    = armed;
+    link(i);
+    ++stats_.active;
+    rearm_driver();
+    return timer_id{i, e.gen};
+  }
+
+  void release(std::uint32_t i) {
+    entry& e = entries_[i];
+    e.fn    = nullptr;
+    e.state = free_slot;
+    ++e.gen;
+    free_.push_back(i);
+    --stats_.active;
+  }
+
+  // Classic hierarchical placement: the level follows from how far away the
+  // deadline is, the slot from its absolute tick. Deadlines beyond the top
+  // level park at its far end and are re-linked when they get there.
+  void link(std::uint32_t i) {
+    entry& e = entries_[i];
+    std::uint64_t placed = e.deadline;
+    std::uint64_t delta  = placed - now_tick_;
+    if (delta >= kReach) {
+      delta  = kReach - 1;
+      placed = now_tick_ + delta;
+    }
+    const int level = delta ? (int)(std::bit_width(delta) - 1) / kBits : 0;
+    const auto slot = (std::uint8_t)((placed >> (kBits * level)) & (kSlots - 1));
+    e.level = (std::uint8_t)level;
+    e.slot  = slot;
+    e.prev  = kNil;
+    e.next  = heads_[level][slot];
+    if (e.next != kNil) entries_[e.next].prev = i;
+    heads_[level][slot] = i;
+    occupied_[level] |= std::uint64_t{1} << slot;
+  }
+
+  void unlink(std::uint32_t i) {
+    entry& e = entries_[i];
+    if (e.prev != kNil) entries_[e.prev].next = e.next;
+    else heads_[e.level][e.slot] = e.next;
+    if (e.next != kNil) entries_[e.next].prev = e.prev;
+    if (heads_[e.level][e.slot] == kNil) occupied_[e.level] &= ~(std::uint64_t{1} << e.slot);
+    e.prev = e.next = kNil;
+  }
+
+  // First tick at which some slot has to be processed, or kNever. A level-L
+  // slot is processed when the wheel reaches the start of its block; the
+  // slots wrap around, so the search starts right after the current one.
+  std::uint64_t next_event() const {
+    std::uint64_t best = kNever;
+    for (int level = 0; level < kLevels; ++level) {
+      const std::uint64_t occ = occupied_[level];
+      if (!occ) continue;
+      const int shift = kBits * level;
+      const auto cur  = (int)((now_tick_ >> shift) & (kSlots - 1));
+      const auto dist = (std::uint64_t)std::countr_zero(std::rotr(occ, (cur + 1) & (kSlots - 1))) + 1;
+      best = std::min(best, ((now_tick_ >> shift) + dist) << shift);
+    }
+    return best;
+  }
+
+  // Moves the wheel to `target`, visiting only ticks with work, and queues
+  // the due timers in fire_.
+  void advance(std::uint64_t target) {
+    target_ = target;
+    for (;;) {
+      const std::uint64_t t = next_event();
+      if (t > target) break;
+      now_tick_ = t;
+      // Higher levels first, so their entries can land in this tick's level-0 slot.
+      for (int level = kLevels - 1; level >= 1; --level) {
+        const int shift = kBits * level;
+        if (t & ((std::uint64_t{1} << shift) - 1)) continue;
+        cascade(level, (unsigned)((t >> shift) & (kSlots - 1)));
+      }
+      expire((unsigned)(t & (kSlots - 1)));
+    }
+    if (target > now_tick_) now_tick_ = target;
+  }
+
+  void cascade(int level, unsigned slot) {
+    std::uint32_t i = heads_[level][slot];
+    heads_[level][slot] = kNil;
+    occupied_[level] &= ~(std::uint64_t{1} << slot);
+    while (i != kNil) {
+      const std::uint32_t next = entries_[i].next;
+      link(i);
+      ++stats_.cascaded;
+      i = next;
+    }
+  }
+
+  void expire(unsigned slot) {
+    std::uint32_t i = heads_[0][slot];
+    heads_[0][slot] = kNil;
+    occupied_[0] &= ~(std::uint64_t{1} << slot);
+    while (i != kNil) {
+      entry& e = entries_[i];
+      const std::uint32_t next = e.next;
+      e.prev = e.next = kNil;
+      if (e.deadline > now_tick_) {
+        link(i); // parked beyond the wheel's reach
+      } else {
+        fire_.push_back(timer_id{i, e.gen});
+        if (e.period) {
+          e.deadline += e.period;
+          if (e.deadline <= target_) {
+            const std::uint64_t late = (target_ - e.deadline) / e.period + 1;
+            stats_.missed += late;
+            e.deadline += late * e.period;
+          }
+          link(i);
+        } else {
+          e.state = firing;
+        }
+      }
+      i = next;
+    }
+  }
+
+  // === Driver (real clock only) ===
+  void start_driver() {
+    driver_ = std::make_shared<driver>();
+    std::shared_ptr<driver> d = driver_;
+    executor* ui = &ui_;
+    timer_service* self = this;
+    d->thread = std::thread([d, ui, self] {
+      std::unique_lock<std::mutex> lock(d->mx);
+      for (;;) {
+        if (d->stopping) return;
+        if (d->posted || d->wake_ns == std::numeric_limits<std::int64_t>::max()) {
+          d->cv.wait(lock);
+          continue;
+        }
+        const auto now = steady_timer_clock::instance().now().count();
+        if (now < d->wake_ns) {
+          d->cv.wait_for(lock, std::chrono::nanoseconds(d->wake_ns - now));
+          continue;
+        }
+        d->posted = true;
+        lock.unlock();
+        ui->post([d, self] {
+          {
+            std::lock_guard<std::mutex> l(d->mx);
+            if (!d->alive) return;
+          }
+          self->poll(); // sets the next wake_ns
+          {
+            std::lock_guard<std::mutex> l(d->mx);
+            d->posted = false;
+          }
+          d->cv.notify_one();
+        });
+        lock.lock();
+      }
+    });
+  }
+
+  // Tells the driver about the earliest deadline.
+  void rearm_driver() {
+    if (!driver_) return;
+    const std::uint64_t t = next_event();
+    const std::int64_t wake = t == kNever ? std::numeric_limits<std::int64_t>::max()
+                                          : (std::int64_t)t * resolution_.count();
+    bool earlier;
+    {
+      std::lock_guard<std::mutex> lock(driver_->mx);
+      earlier = wake < driver_->wake_ns;
+      driver_->wake_ns = wake;
+    }
+    if (earlier) driver_->cv.notify_one();
+  }
+
+  executor& ui_;
+  timer_clock& clock_;
+  duration resolution_;
+  std::uint64_t now_tick_{0};
+  std::uint64_t target_{0}; // tick being advanced to
+
+  std::vector<entry> entries_;
+  std::vector<std::uint32_t> free_;
+  std::array<std::array<std::uint32_t, kSlots>, kLevels> heads_{};
+  std::array<std::uint64_t, kLevels> occupied_{};
+  std::vector<timer_id> fire_;
+  timer_stats stats_;
+
+  std::shared_ptr<driver> driver_;
+};
+
+// Cancels its timer when destroyed, like pulse::subscription for observables.
+class scoped_timer {
+public:
+  scoped_timer() = default;
+  scoped_timer(timer_service& ts, timer_id id) : ts_(&ts), id_(id) {}
+  ~scoped_timer() { reset(); }
+
+  scoped_timer(scoped_timer&& o) noexcept : ts_(std::exchange(o.ts_, nullptr)), id_(o.id_) {}
+  scoped_timer& operator=(scoped_timer&& o) noexcept {
+    if (this != &o) {
+      reset();
+      ts_ = std::exchange(o.ts_, nullptr);
+      id_ = o.id_;
+    }
+    return *this;
+  }
+
+  void reset() {
+    if (ts_) ts_->cancel(id_);
+    ts_ = nullptr;
+  }
+
+  explicit operator bool() const { return ts_ && ts_->active(id_); }
+  timer_id id() const { return id_; }
+
+private:
+  timer_service* ts_{nullptr};
+  timer_id id_{};
+};
+
+} // namespace pulseui::core
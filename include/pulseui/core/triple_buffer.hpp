@@ -0,0 +1,57 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+namespace pulseui::core {
+
+// Lock-free single-writer/single-reader handoff of the latest value. The
+// writer fills back() and publish()es it; the reader calls update() and reads
+// front(). Neither side ever waits for the other, the reader always sees a
+// complete value, and values the reader never got to are simply replaced.
+//
+//   writer:  buf.back() = next; buf.publish();
+//   reader:  buf.update(); use(buf.front());
+template <class T>
+class triple_buffer {
+public:
+  triple_buffer() = default;
+  explicit triple_buffer(const T& initial) : slots_{initial, initial, initial} {}
+
+  triple_buffer(const triple_buffer&) = delete;
+  triple_buffer& operator=(const triple_buffer&) = delete;
+
+  // === Writer ===
+  T& back() { return slots_[back_]; }
+
+  // Hands back() to the reader. Returns true if the reader had already
+  // taken the previous value (i.e. this publish makes it stale again), which
+  // is when it needs a notification.
+  bool publish() {
+    const std::uint8_t old = middle_.exchange((std::uint8_t)(back_ | kFresh), std::memory_order_acq_rel);
+    back_ = old & kIndex;
+    return (old & kFresh) == 0;
+  }
+
+  // === Reader ===
+  // Takes the latest published value, if any. Returns true if front() changed.
+  bool update() {
+    if ((middle_.load(std::memory_order_relaxed) & kFresh) == 0) return false;
+    front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndex;
+    return true;
+  }
+
+  const T& front() const { return slots_[front_]; }
+  T& front() { return slots_[front_]; }
+
+private:
+  static constexpr std::uint8_t kIndex = 3;
+  static constexpr std::uint8_t kFresh = 4;
+
+  T slots_[3]{};
+  std::uint8_t back_{0};                // writer
+  alignas(64) std::atomic<std::uint8_t> middle_{1};
+  alignas(64) std::uint8_t front_{2};   // reader
+};
+
+} // namespace pulseui::core
@@ -0,0 +1,142 @@
+#pragma once
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <version>
+#if defined(__cpp_lib_format)
+  #include <format>
+#endif
+
+// Formatting into a caller-owned string (typically a std::pmr::string on a
+// frame arena) for Canvas::draw_textf. Uses std::format where the standard
+// library has it; otherwise a small fallback that understands "{}", "{{",
+// "}}" and a precision and type for floating point ("{:.2f}", "{:.3}",
+// "{:e}"), following std::format: no type with a precision is general
+// format, 'f' without one means 6 digits. It formats integers, floating
+// point, bool, char and anything convertible to std::string_view. Other
+// format specs are ignored by the fallback.
+namespace pulseui::detail {
+
+#if defined(__cpp_lib_format)
+
+template <class... Args>
+using format_string = std::format_string<Args...>;
+
+template <class String, class... Args>
+void format_append(String& out, format_string<Args...> fmt, Args&&... args) {
+  std::format_to(std::back_inserter(out), fmt, std::forward<Args>(args)...);
+}
+
+#else
+
+template <class... Args>
+using format_string = std::type_identity_t<std::string_view>;
+
+template <class String>
+void format_chars(String& out, const char* first, const char* last) {
+  out.append(first, (std::size_t)(last - first));
+}
+
+// Precision (-1 if none) and presentation type (0 if none) of a "{:...}" spec.
+struct format_spec {
+  int precision{-1};
+  char type{0};
+};
+
+inline format_spec parse_format_spec(std::string_view spec) {
+  format_spec fs;
+  if (!spec.empty() && std::string_view("aAeEfFgG").find(spec.back()) != std::string_view::npos) {
+    fs.type = spec.back();
+    spec.remove_suffix(1);
+  }
+  const std::size_t dot = spec.find('.');
+  if (dot == std::string_view::npos) return fs;
+  fs.precision = 0;
+  for (std::size_t i = dot + 1; i < spec.size() && spec[i] >= '0' && spec[i] <= '9'; ++i) {
+    fs.precision = std::min(fs.precision * 10 + (spec[i] - '0'), 30);
+  }
+  return fs;
+}
+
+template <class String, class T>
+void format_arg(String& out, const T& v, format_spec fs) {
+  using U = std::remove_cvref_t<T>;
+  char buf[64];
+  if constexpr (std::is_same_v<U, bool>) {
+    out.append(v ? "true" : "false");
+  } else if constexpr (std::is_same_v<U, char>) {
+    out.push_back(v);
+  } else if constexpr (std::is_integral_v<U>) {
+    const auto r = std::to_chars(buf, buf + sizeof buf, v);
+    format_chars(out, buf, r.ptr);
+  } else if constexpr (std::is_floating_point_v<U>) {
+    std::chars_format cf = std::chars_format::general;
+    switch (fs.type) {
+      case 'a': case 'A': cf = std::chars_format::hex; break;
+      case 'e': case 'E': cf = std::chars_format::scientific; break;
+      case 'f': case 'F': cf = std::chars_format::fixed; break;
+      default: break;
+    }
+    if (fs.precision < 0 && (cf == std::chars_format::fixed || cf == std::chars_format::scientific ||
+                             fs.type == 'g' || fs.type == 'G')) {
+      fs.precision = 6;
+    }
+    const auto r = fs.precision >= 0 ? std::to_chars(buf, buf + sizeof buf, v, cf, fs.precision)
+                 : fs.type           ? std::to_chars(buf, buf + sizeof buf, v, cf)
+                                     : std::to_chars(buf, buf + sizeof buf, v);
+    if (r.ec != std::errc{}) return;
+    if (fs.type >= 'A' && fs.type <= 'Z') {
+      for (char* p = buf; p != r.ptr; ++p) if (*p >= 'a' && *p <= 'z') *p = (char)(*p - 'a' + 'A');
+    }
+    format_chars(out, buf, r.ptr);
+  } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+    out.append(std::string_view(v));
+  } else {
+    static_assert(sizeof(T) == 0, "draw_textf: argument type not supported without <format>");
+  }
+}
+
+// Appends fmt up to the next replacement field; false at the end. spec gets
+// the text after ':' inside the field.
+template <class String>
+bool format_literal(String& out, std::string_view& fmt, std::string_view& spec) {
+  while (!fmt.empty()) {
+    const std::size_t i = fmt.find_first_of("{}");
+    out.append(fmt.substr(0, i));
+    if (i == std::string_view::npos) { fmt = {}; return false; }
+    const char c = fmt[i];
+    if (i + 1 < fmt.size() && fmt[i + 1] == c) { // "{{" or "}}"
+      out.push_back(c);
+      fmt.remove_prefix(i + 2);
+      continue;
+    }
+    if (c == '}') { out.push_back(c); fmt.remove_prefix(i + 1); continue; }
+    const std::size_t close = fmt.find('}', i);
+    if (close == std::string_view::npos) { fmt = {}; return false; }
+    const std::string_view field = fmt.substr(i + 1, close - i - 1);
+    const std::size_t colon = field.find(':');
+    spec = colon == std::string_view::npos ? std::string_view{} : field.substr(colon + 1);
+    fmt.remove_prefix(close + 1);
+    return true;
+  }
+  return false;
+}
+
+template <class String, class... Args>
+void format_append(String& out, format_string<Args...> fmt, Args&&... args) {
+  std::string_view rest = fmt, spec;
+  auto one = [&](const auto& v) {
+    if (format_literal(out, rest, spec)) format_arg(out, v, parse_format_spec(spec));
+  };
+  (one(args), ...);
+  while (format_literal(out, rest, spec)) {} // fields without arguments print nothing
+}
+
+#endif
+
+} // namespace pulseui::detail
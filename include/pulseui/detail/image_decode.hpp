@@ -0,0 +1,174 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+// Header parsing and decoding for the image formats ui::Image reads. Pixels
+// come out as straight-alpha RGBA8 words, R in the low byte.
+namespace pulseui::detail {
+
+enum class image_format : std::uint8_t { none, pam_rgba, pam_rgb, ppm, qoi };
+
+struct image_header {
+  image_format format{image_format::none};
+  int width{0}, height{0};
+  std::size_t offset{0}; // first pixel byte (PNM) or first chunk (QOI)
+};
+
+namespace pnm {
+  inline bool space(std::uint8_t c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f'; }
+
+  // Skips whitespace and # comments.
+  inline void skip(const std::uint8_t* d, std::size_t n, std::size_t& i) {
+    while (i < n) {
+      if (d[i] == '#') {
+        while (i < n && d[i] != '\n') ++i;
+      } else if (space(d[i])) {
+        ++i;
+      } else {
+        return;
+      }
+    }
+  }
+
+  inline bool number(const std::uint8_t* d, std::size_t n, std::size_t& i, int& out) {
+    skip(d, n, i);
+    long v = 0;
+    const std::size_t start = i;
+    while (i < n && d[i] >= '0' && d[i] <= '9' && v < (1L << 24)) v = v * 10 + (d[i++] - '0');
+    out = (int)v;
+    return i > start && v > 0;
+  }
+
+  inline std::string_view token(const std::uint8_t* d, std::size_t n, std::size_t& i) {
+    skip(d, n, i);
+    const std::size_t start = i;
+    while (i < n && !space(d[i])) ++i;
+    return std::string_view(reinterpret_cast<const char*>(d) + start, i - start);
+  }
+
+  // P6 (binary PPM): width height maxval, one whitespace byte, RGB bytes.
+  inline image_header ppm(const std::uint8_t* d, std::size_t n) {
+    image_header h;
+    std::size_t i = 2;
+    int maxval = 0;
+    if (!number(d, n, i, h.width) || !number(d, n, i, h.height) || !number(d, n, i, maxval)) return {};
+    if (maxval != 255 || i >= n || !space(d[i])) return {};
+    h.offset = i + 1;
+    h.format = image_format::ppm;
+    return h;
+  }
+
+  // P7 (PAM): key/value lines up to ENDHDR; RGB or RGB_ALPHA at maxval 255.
+  inline image_header pam(const std::uint8_t* d, std::size_t n) {
+    image_header h;
+    std::size_t i = 2;
+    int depth = 0, maxval = 0;
+    for (;;) {
+      const std::string_view key = token(d, n, i);
+      if (key.empty()) return {};
+      if (key == "ENDHDR") break;
+      if (key == "WIDTH") { if (!number(d, n, i, h.width)) return {}; }
+      else if (key == "HEIGHT") { if (!number(d, n, i, h.height)) return {}; }
+      else if (key == "DEPTH") { if (!number(d, n, i, depth)) return {}; }
+      else if (key == "MAXVAL") { if (!number(d, n, i, maxval)) return {}; }
+      else if (key == "TUPLTYPE") { token(d, n, i); }
+      else return {};
+    }
+    if (i >= n || d[i] != '\n' || maxval != 255 || h.width <= 0 || h.height <= 0) return {};
+    h.offset = i + 1;
+    if (depth == 4) h.format = image_format::pam_rgba;
+    else if (depth == 3) h.format = image_format::pam_rgb;
+    else return {};
+    return h;
+  }
+} // namespace pnm
+
+inline std::uint32_t load_be32(const std::uint8_t* p) {
+  return (std::uint32_t)p[0] << 24 | (std::uint32_t)p[1] << 16 | (std::uint32_t)p[2] << 8 | p[3];
+}
+
+// Recognizes the format and reads the dimensions; touches only the header.
+inline image_header read_image_header(const std::uint8_t* d, std::size_t n) {
+  image_header h;
+  if (n >= 3 && d[0] == 'P' && d[1] == '6') h = pnm::ppm(d, n);
+  else if (n >= 3 && d[0] == 'P' && d[1] == '7') h = pnm::pam(d, n);
+  else if (n >= 14 + 8 && std::memcmp(d, "qoif", 4) == 0) {
+    h.width  = (int)load_be32(d + 4);
+    h.height = (int)load_be32(d + 8);
+    h.offset = 14;
+    h.format = image_format::qoi;
+  }
+  if (h.width <= 0 || h.height <= 0 || (std::uint64_t)h.width * (std::uint64_t)h.height > (1u << 28)) return {};
+  const std::size_t channels = h.format == image_format::pam_rgba ? 4 : 3;
+  if (h.format != image_format::qoi && h.offset + (std::size_t)h.width * h.height * channels > n) return {};
+  return h;
+}
+
+// PPM / RGB PAM: adds an opaque alpha byte.
+inline void expand_rgb(const std::uint8_t* src, std::size_t pixels, std::uint32_t* out) {
+  for (std::size_t i = 0; i < pixels; ++i, src += 3) {
+    out[i] = (std::uint32_t)src[0] | (std::uint32_t)src[1] << 8 | (std::uint32_t)src[2] << 16 | 0xFF000000u;
+  }
+}
+
+inline void copy_rgba(const std::uint8_t* src, std::size_t pixels, std::uint32_t* out) {
+  for (std::size_t i = 0; i < pixels; ++i, src += 4) {
+    out[i] = (std::uint32_t)src[0] | (std::uint32_t)src[1] << 8 | (std::uint32_t)src[2] << 16 | (std::uint32_t)src[3] << 24;
+  }
+}
+
+// QOI (qoiformat.org) chunks starting at d[h.offset]. Returns false on a
+// truncated stream; the pixels decoded so far are kept.
+inline bool decode_qoi(const std::uint8_t* d, std::size_t n, const image_header& h, std::uint32_t* out) {
+  struct rgba { std::uint8_t r, g, b, a; };
+  rgba index[64]{};
+  rgba px{0, 0, 0, 255};
+  const std::size_t total = (std::size_t)h.width * (std::size_t)h.height;
+  const std::size_t end = n >= 8 ? n - 8 : 0; // 8-byte end marker
+  std::size_t i = h.offset;
+  int run = 0;
+  for (std::size_t p = 0; p < total; ++p) {
+    if (run > 0) {
+      --run;
+    } else {
+      if (i >= end) return false;
+      const std::uint8_t b1 = d[i++];
+      if (b1 == 0xFE) {
+        if (i + 3 > end) return false;
+        px.r = d[i]; px.g = d[i + 1]; px.b = d[i + 2];
+        i += 3;
+      } else if (b1 == 0xFF) {
+        if (i + 4 > end) return false;
+        px = rgba{d[i], d[i + 1], d[i + 2], d[i + 3]};
+        i += 4;
+      } else {
+        switch (b1 >> 6) {
+          case 0: px = index[b1]; break;
+          case 1:
+            px.r = (std::uint8_t)(px.r + ((b1 >> 4) & 3) - 2);
+            px.g = (std::uint8_t)(px.g + ((b1 >> 2) & 3) - 2);
+            px.b = (std::uint8_t)(px.b + (b1 & 3) - 2);
+            break;
+          case 2: {
+            if (i >= end) return false;
+            const std::uint8_t b2 = d[i++];
+            const int dg = (b1 & 0x3F) - 32;
+            px.r = (std::uint8_t)(px.r + dg - 8 + ((b2 >> 4) & 0x0F));
+            px.g = (std::uint8_t)(px.g + dg);
+            px.b = (std::uint8_t)(px.b + dg - 8 + (b2 & 0x0F));
+            break;
+          }
+          default: run = b1 & 0x3F; break;
+        }
+      }
+      index[(px.r * 3 + px.g * 5 + px.b * 7 + px.a * 11) % 64] = px;
+    }
+    out[p] = (std::uint32_t)px.r | (std::uint32_t)px.g << 8 | (std::uint32_t)px.b << 16 | (std::uint32_t)px.a << 24;
+  }
+  return true;
+}
+
+} // namespace pulseui::detail
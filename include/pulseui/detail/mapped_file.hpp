@@ -0,0 +1,89 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#if defined(_WIN32)
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace pulseui::detail {
+
+// Read-only memory map of a whole file. Pages are read in on first touch and
+// can be dropped by the OS at any time, so a mapped file costs no heap.
+class mapped_file {
+public:
+  // nullptr if the file cannot be opened or is empty.
+  static std::shared_ptr<const mapped_file> open(const std::string& path) {
+    std::shared_ptr<mapped_file> f(new mapped_file());
+    return f->map(path) ? f : nullptr;
+  }
+
+  ~mapped_file() {
+#if defined(_WIN32)
+    if (data_) UnmapViewOfFile(data_);
+#else
+    if (data_) munmap(const_cast<std::uint8_t*>(data_), size_);
+#endif
+  }
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  const std::uint8_t* data() const { return data_; }
+  std::size_t size() const { return size_; }
+
+private:
+  mapped_file() = default;
+
+#if defined(_WIN32)
+  bool map(const std::string& path) {
+    const int wlen = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    std::wstring wpath(wlen > 0 ? wlen : 0, L'\0');
+    if (wlen > 0) MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, wpath.data(), wlen);
+    HANDLE file = CreateFileW(wpath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size{};
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+      mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    CloseHandle(file);
+    if (!mapping) return false;
+    data_ = static_cast<const std::uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    CloseHandle(mapping); // the view keeps the mapping alive
+    size_ = data_ ? (std::size_t)size.QuadPart : 0;
+    return data_ != nullptr;
+  }
+#else
+  bool map(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct stat st{};
+    void* p = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+      p = mmap(nullptr, (std::size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd); // the mapping keeps the file alive
+    if (p == MAP_FAILED) return false;
+    data_ = static_cast<const std::uint8_t*>(p);
+    size_ = (std::size_t)st.st_size;
+    return true;
+  }
+#endif
+
+  const std::uint8_t* data_{nullptr};
+  std::size_t size_{0};
+};
+
+} // namespace pulseui::detail
@@ -0,0 +1,202 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <pulseui/ui/canvas.hpp>
+#include <pulseui/ui/display_list.hpp>
+#include <pulseui/ui/input_queue.hpp>
+#include <pulseui/ui/window.hpp>
+
+// Headless backend: windows render into in-memory RGBA8 framebuffers.
+// Available on every OS; selected automatically where no native backend exists.
+
+namespace pulseui::platform {
+
+// Packs a color into a premultiplied RGBA8 pixel (byte order R,G,B,A in memory).
+inline std::uint32_t to_rgba8(ui::Color c) {
+  auto clamp = [](float x) {
+    if (x < 0.f) return 0.f;
+    if (x > 1.f) return 1.f;
+    return x;
+  };
+  const float a = clamp(c.a);
+  const auto R = (std::uint32_t)(clamp(c.r) * a * 255.0f + 0.5f);
+  const auto G = (std::uint32_t)(clamp(c.g) * a * 255.0f + 0.5f);
+  const auto B = (std::uint32_t)(clamp(c.b) * a * 255.0f + 0.5f);
+  const auto A = (std::uint32_t)(a * 255.0f + 0.5f);
+  return R | (G << 8) | (B << 16) | (A << 24);
+}
+
+struct Framebuffer {
+  int width{}, height{};
+  std::vector<std::uint32_t> pixels; // premultiplied RGBA8, row-major, stride == width
+
+  void resize(int w, int h) {
+    width  = w > 0 ? w : 0;
+    height = h > 0 ? h : 0;
+    pixels.assign((std::size_t)width * (std::size_t)height, 0u);
+  }
+
+  std::uint32_t  at(int x, int y) const { return pixels[(std::size_t)y * width + x]; }
+  std::uint32_t* row(int y)             { return pixels.data() + (std::size_t)y * width; }
+};
+
+// Software canvas over a Framebuffer. Fills use vectorized span kernels
+// (AVX2/SSE2 when available) with source-over blending for translucent colors.
+class RasterCanvas final : public ui::Canvas {
+public:
+  explicit RasterCanvas(Framebuffer& fb);
+
+  void clear(ui::Color c) override;
+  void fill_rect(ui::Rect r, ui::Color c) override;
+  void draw_text(ui::Point p, std::string_view text, const ui::Font& f, ui::Color c) override;
+  // Nearest-neighbour scaling from the closest mip level.
+  void draw_image(ui::Rect dst, const ui::Image& img, float opacity) override;
+  ui::TextMetrics measure_text(std::string_view text, const ui::Font& f) override;
+  float dpi_scale() const override { return dpi_scale_; }
+
+  const ui::Region* damage() const override { return damage_; }
+
+  // Scale of the simulated display (HeadlessWindow passes its own); only
+  // picks image mip levels, drawing stays in framebuffer pixels.
+  void set_dpi_scale(float s) { dpi_scale_ = s > 0 ? s : 1.f; }
+
+  // Restricts all drawing to r (intersected with the framebuffer bounds).
+  void set_clip(ui::Rect r);
+  void reset_clip();
+  // Restricts drawing to the rects of d as well; nullptr lifts the restriction.
+  // d must outlive the canvas.
+  void set_damage(const ui::Region* d);
+
+private:
+  struct Box { int x0, y0, x1, y1; };
+
+  void update_boxes();
+  void fill_pixels(int x0, int y0, int x1, int y1, std::uint32_t px);
+
+  Framebuffer& fb_;
+  Box clip_{};
+  const ui::Region* damage_{nullptr};
+  std::array<Box, ui::Region::kMaxRects> boxes_{};
+  std::size_t box_count_{0};
+  float dpi_scale_{1.f};
+};
+
+struct TileStats {
+  std::uint64_t frames{};
+  std::uint64_t tiles{};     // non-empty tiles rasterized
+  std::uint64_t binned{};    // command/tile pairs
+  // Binned commands dropped by a later clear or opaque fill covering their tile.
+  std::uint64_t discarded{};
+  std::uint64_t stolen{};    // tiles run by a thread other than their owner
+  unsigned threads{};
+};
+
+// Offscreen rasterizer for big frames: render() bins a DisplayList's commands
+// into tile x tile screen tiles and rasterizes the tiles in parallel on a
+// work-stealing pool (the calling thread takes part). Commands keep their
+// order within a tile, so the result is pixel-identical to replaying the list
+// on a RasterCanvas. Text runs and image surfaces come from caches owned by
+// the rasterizer, not the UI thread's, so render() may be called from any
+// thread (one call at a time per rasterizer).
+//
+//   TileRasterizer tiles;            // one thread per core
+//   tiles.render(list, fb);          // fb sized by the caller
+class TileRasterizer {
+public:
+  explicit TileRasterizer(unsigned threads = 0, int tile = 128);
+  ~TileRasterizer();
+
+  TileRasterizer(const TileRasterizer&) = delete;
+  TileRasterizer& operator=(const TileRasterizer&) = delete;
+
+  void render(const ui::DisplayList& list, Framebuffer& fb);
+  // Same as RasterCanvas::set_dpi_scale, so both pick the same mip levels.
+  void set_dpi_scale(float s);
+
+  unsigned threads() const;
+  int tile_size() const;
+  const TileStats& stats() const;
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+class HeadlessWindow final : public ui::Window {
+public:
+  HeadlessWindow(int width, int height, std::string title);
+  ~HeadlessWindow() override;
+
+  // === ui::Window overrides ===
+  void set_title(std::string title) override { title_ = std::move(title); }
+  void invalidate() override;
+  void invalidate(ui::Rect r) override;
+  // Blits the framebuffer for whole-pixel offsets; repaints area otherwise.
+  void scroll(ui::Rect area, float dx, float dy) override;
+  float dpi_scale() const override { return dpi_scale_; }
+  void on_paint(PaintCB cb) override;
+  void on_input(InputCB cb) override { input_cb_ = std::move(cb); }
+  void on_input_batch(InputBatchCB cb) override { input_batch_cb_ = std::move(cb); }
+  void set_keep_move_history(bool on) override { input_queue_.set_keep_move_history(on); }
+  std::span<const ui::InputEvent> move_history() const override {
+    return input_queue_.delivered_move_history();
+  }
+
+  // Renders the whole window now, regardless of the invalidation state.
+  void paint();
+  // Renders a frame only if the window was invalidated since the last paint.
+  // Only the accumulated damage region is repainted.
+  bool paint_if_needed();
+  bool needs_paint() const { return dirty_.load(std::memory_order_acquire); }
+
+  // Feeds an event through the input callbacks as if it came from the OS.
+  // A zero timestamp is replaced with ui::input_timestamp().
+  void send_input(ui::InputEvent e);
+  // Delivers the coalesced batch; run_pending() does this before painting.
+  bool flush_input();
+  const ui::InputQueue& input_queue() const { return input_queue_; }
+
+  void resize(int width, int height);
+  void set_dpi_scale(float s) { dpi_scale_ = s; invalidate(); }
+
+  const std::string& title() const { return title_; }
+  const Framebuffer& framebuffer() const { return fb_; }
+  std::uint64_t frame_count() const { return frames_; }
+
+private:
+  // Sets dirty_ and wakes app_run() if it was clear.
+  void mark_dirty();
+
+  std::string title_;
+  Framebuffer fb_;
+  float dpi_scale_{1.f};
+  std::atomic<bool> dirty_{true};
+  std::mutex damage_mx_;
+  ui::Region damage_;       // guarded by damage_mx_
+  bool full_damage_{true};  // guarded by damage_mx_
+  ui::Region paint_damage_; // region of the frame being painted
+  std::uint64_t frames_{0};
+  PaintCB paint_cb_{};
+  InputCB input_cb_{};
+  InputBatchCB input_batch_cb_{};
+  ui::InputQueue input_queue_;
+};
+
+std::unique_ptr<HeadlessWindow> make_headless_window(int width, int height, const std::string& title);
+
+// Runs the tasks posted to UI executors so far, then repaints invalidated windows.
+// Returns false when there was nothing to do. app_run() loops on this, sleeping
+// while it returns false, until app_quit(); tests can call it directly to run
+// until idle.
+bool run_pending();
+
+// Name of the span kernel set compiled in: "avx2", "sse2" or "scalar".
+const char* raster_simd_level();
+
+} // namespace pulseui::platform
@@ -2,6 +2,7 @@
 #include <memory>
 #include <string>
 #include <pulseui/core/executor.hpp>
+#include <pulseui/ui/text_cache.hpp>
 #include <pulseui/ui/window.hpp>
 
 namespace pulseui::platform {
@@ -10,6 +11,13 @@ namespace pulseui::platform {
   std::unique_ptr<pulseui::ui::Window> make_window(int width, int height, const std::string& title);
 
   void app_init();
+  // Runs the UI loop until app_quit() (or the OS ends the application).
   void app_run();
+  // Makes app_run() return. Call on the UI thread (the headless backend
+  // also accepts other threads).
+  void app_quit();
+
+  // Counters of the backend's text run cache (UI thread).
+  ui::TextCacheStats text_cache_stats();
 }
 
@@ -1,2 +1,14 @@
 #pragma once
-// placeholder: platform timers if needed directly
+#include <memory>
+#include <pulseui/core/timer_service.hpp>
+#include <pulseui/platform/platform.hpp>
+
+namespace pulseui::platform {
+  // Process-wide timer service on the UI executor, created on first use.
+  // UI thread only, like the service itself.
+  inline core::timer_service& timers() {
+    static std::unique_ptr<core::executor> ui = make_ui_executor();
+    static core::timer_service service(*ui);
+    return service;
+  }
+}
@@ -5,12 +5,31 @@
 #include <pulseui/core/executor.hpp>
 #include <pulseui/core/reactive.hpp>
 #include <pulseui/core/store.hpp>
+#include <pulseui/core/batched_store.hpp>
+#include <pulseui/core/async_store.hpp>
+#include <pulseui/core/cow.hpp>
+#include <pulseui/core/selector.hpp>
+#include <pulseui/core/scheduler.hpp>
+#include <pulseui/core/timer_service.hpp>
+#include <pulseui/core/frame_scheduler.hpp>
+#include <pulseui/core/frame_arena.hpp>
+#include <pulseui/core/profiler.hpp>
 
 #include <pulseui/ui/window.hpp>
 #include <pulseui/ui/canvas.hpp>
 #include <pulseui/ui/input.hpp>
+#include <pulseui/ui/input_queue.hpp>
 #include <pulseui/ui/layout.hpp>
 #include <pulseui/ui/widget.hpp>
+#include <pulseui/ui/widget_container.hpp>
+#include <pulseui/ui/virtual_list.hpp>
+#include <pulseui/ui/display_list.hpp>
+#include <pulseui/ui/batching_canvas.hpp>
+#include <pulseui/ui/overdraw.hpp>
+#include <pulseui/ui/image.hpp>
+#include <pulseui/ui/image_cache.hpp>
+#include <pulseui/ui/animation.hpp>
 #include <pulseui/ui/button.hpp>
+#include <pulseui/ui/widget_pool.hpp>
 
 #include <pulseui/platform/platform.hpp>
@@ -0,0 +1,320 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <pulse/pulse.hpp>
+#include <pulseui/core/executor.hpp>
+#include <pulseui/core/frame_scheduler.hpp>
+#include <pulseui/core/profiler.hpp>
+#include <pulseui/ui/input.hpp>
+
+namespace pulseui::ui {
+
+enum class Ease : std::uint8_t { Linear, InQuad, OutQuad, InOutQuad, InCubic, OutCubic, InOutCubic, Smooth };
+
+template <class T>
+struct Tween {
+  T from{}, to{};
+  std::chrono::nanoseconds duration{std::chrono::milliseconds(150)};
+  Ease ease{Ease::OutCubic};
+  std::chrono::nanoseconds delay{};
+};
+
+struct AnimationId {
+  std::uint32_t index{std::numeric_limits<std::uint32_t>::max()};
+  std::uint32_t gen{0};
+  explicit operator bool() const { return index != std::numeric_limits<std::uint32_t>::max(); }
+};
+
+// Published once per animation frame, after all values were delivered.
+struct AnimationFrame {
+  std::uint64_t index{};
+  std::chrono::steady_clock::time_point time{};
+  std::size_t updated{};  // animations that produced a new value
+  std::size_t active{};   // still running afterwards
+};
+
+struct AnimationStats {
+  std::uint64_t started{};
+  std::uint64_t finished{};
+  std::uint64_t cancelled{};
+  std::uint64_t frames{};
+  std::uint64_t evaluated{}; // tween steps over all frames
+};
+
+// Runs every tween of a UI on one frame clock. Active tweens live in
+// structure-of-arrays form (progress, rate, easing polynomial, four value
+// lanes per tween), so a frame is a few straight loops over contiguous
+// floats that the compiler vectorizes, followed by the value callbacks.
+// Floats use one lane; Color and Rect use four.
+//
+//   ui::Animator anim(*ui_exec);
+//   auto a = anim.start(Tween<float>{0.f, 1.f, 200ms}, [&](float v){ opacity = v; });
+//   auto sub = anim.frames().subscribe([&](const AnimationFrame&){ win->invalidate(); });
+//
+// Frames come from an internal core::frame_scheduler that is only asked for
+// a frame while something is animating, so an idle Animator costs nothing.
+// UI thread only; callbacks may start and cancel animations. Must outlive
+// the ScopedAnimations (and widgets) using it.
+class Animator {
+public:
+  using clock = std::chrono::steady_clock;
+
+  explicit Animator(core::executor& ui,
+                    std::chrono::nanoseconds interval = std::chrono::nanoseconds(16'666'667))
+    : frames_(ui, interval) {
+    frames_.on_frame([this](const core::frame_info& f) { advance(f.time); });
+  }
+
+  Animator(const Animator&) = delete;
+  Animator& operator=(const Animator&) = delete;
+
+  AnimationId start(const Tween<float>& t, std::function<void(float)> on_value) {
+    const std::array<float, 4> from{t.from, 0, 0, 0}, to{t.to, 0, 0, 0};
+    return add(from, to, t.duration, t.delay, t.ease, [fn = std::move(on_value)](const float* v) { fn(v[0]); });
+  }
+
+  AnimationId start(const Tween<Color>& t, std::function<void(const Color&)> on_value) {
+    const std::array<float, 4> from{t.from.r, t.from.g, t.from.b, t.from.a}, to{t.to.r, t.to.g, t.to.b, t.to.a};
+    return add(from, to, t.duration, t.delay, t.ease,
+               [fn = std::move(on_value)](const float* v) { fn(Color{v[0], v[1], v[2], v[3]}); });
+  }
+
+  AnimationId start(const Tween<Rect>& t, std::function<void(const Rect&)> on_value) {
+    const std::array<float, 4> from{t.from.x, t.from.y, t.from.w, t.from.h}, to{t.to.x, t.to.y, t.to.w, t.to.h};
+    return add(from, to, t.duration, t.delay, t.ease,
+               [fn = std::move(on_value)](const float* v) { fn(Rect{v[0], v[1], v[2], v[3]}); });
+  }
+
+  // Stops without a final value. Returns false if it already finished.
+  bool cancel(AnimationId id) {
+    if (!alive(id)) return false;
+    remove(handles_[id.index].dense);
+    ++stats_.cancelled;
+    return true;
+  }
+
+  bool active(AnimationId id) const { return alive(id); }
+  std::size_t size() const { return progress_.size(); }
+
+  // Every animation frame, on the UI thread.
+  pulse::observable<AnimationFrame> frames() { return pulse::as_observable(frame_out_, inline_pex_); }
+
+  // Steps all tweens to `now` and delivers their values. Normally called by
+  // the frame clock; call it directly to drive animations by hand.
+  void advance(clock::time_point now) {
+    PULSEUI_PROFILE_SCOPE("animate");
+    const float dt = std::chrono::duration<float>(now - last_).count();
+    last_ = now;
+    const std::size_t n = progress_.size();
+    if (n == 0) return;
+
+    // Progress and easing: piecewise cubic, split at t = 0.5.
+    float* p = progress_.data();
+    const float* rate = rate_.data();
+    float* eased = eased_.data();
+    for (std::size_t i = 0; i < n; ++i) {
+      p[i] += dt * rate[i];
+      const float t  = std::clamp(p[i], 0.f, 1.f);
+      const float lo = ((lo3_[i] * t + lo2_[i]) * t + lo1_[i]) * t;
+      const float hi = ((hi3_[i] * t + hi2_[i]) * t + hi1_[i]) * t + hi0_[i];
+      eased[i] = t < 0.5f ? lo : hi;
+    }
+    // Values: from*(1-e) + to*e is exact at both ends.
+    const float* from = from_.data();
+    const float* to = to_.data();
+    float* value = value_.data();
+    for (std::size_t c = 0; c < 4 * n; ++c) {
+      const float e = eased[c / 4];
+      value[c] = from[c] * (1.f - e) + to[c] * e;
+    }
+
+    // Callbacks run from a snapshot of the due tweens: they may start or
+    // cancel animations, which reorders the arrays.
+    due_.clear();
+    for (std::size_t i = 0; i < n; ++i) {
+      if (p[i] > 0.f) due_.push_back(AnimationId{owner_[i], handles_[owner_[i]].gen});
+    }
+    stats_.evaluated += n;
+    for (const AnimationId id : due_) {
+      if (!alive(id)) continue;
+      const std::uint32_t i = handles_[id.index].dense;
+      const bool done = progress_[i] >= 1.f;
+      std::array<float, 4> v;
+      std::copy_n(&value_[4 * (std::size_t)i], 4, v.begin());
+      callback fn = std::move(callbacks_[i]);
+      if (done) {
+        remove(i);
+        ++stats_.finished;
+      }
+      fn(v.data());
+      if (!done && alive(id)) callbacks_[handles_[id.index].dense] = std::move(fn);
+    }
+
+    frame_out_.publish(AnimationFrame{stats_.frames++, now, due_.size(), progress_.size()});
+    if (!progress_.empty()) frames_.request_frame();
+  }
+
+  AnimationStats stats() const { return stats_; }
+
+private:
+  using callback = std::function<void(const float*)>;
+
+  struct handle {
+    std::uint32_t dense{0};
+    std::uint32_t gen{0};
+    bool used{false};
+  };
+
+  // Runs the topic's subscribers right away; frames are on the UI thread already.
+  struct inline_executor final : pulse::executor {
+    void post(std::function<void()> fn) override { fn(); }
+  };
+
+  // t < 0.5: lo3 t^3 + lo2 t^2 + lo1 t; otherwise hi3 t^3 + hi2 t^2 + hi1 t + hi0.
+  struct poly { float lo3, lo2, lo1, hi3, hi2, hi1, hi0; };
+
+  static poly coefficients(Ease e) {
+    switch (e) {
+      case Ease::Linear:     return {0, 0, 1, 0, 0, 1, 0};
+      case Ease::InQuad:     return {0, 1, 0, 0, 1, 0, 0};
+      case Ease::OutQuad:    return {0, -1, 2, 0, -1, 2, 0};
+      case Ease::InOutQuad:  return {0, 2, 0, 0, -2, 4, -1};
+      case Ease::InCubic:    return {1, 0, 0, 1, 0, 0, 0};
+      case Ease::OutCubic:   return {1, -3, 3, 1, -3, 3, 0};
+      case Ease::InOutCubic: return {4, 0, 0, 4, -12, 12, -3};
+      case Ease::Smooth:     return {-2, 3, 0, -2, 3, 0, 0};
+    }
+    return {0, 0, 1, 0, 0, 1, 0};
+  }
+
+  bool alive(AnimationId id) const {
+    return id && id.index < handles_.size() && handles_[id.index].used && handles_[id.index].gen == id.gen;
+  }
+
+  AnimationId add(const std::array<float, 4>& from, const std::array<float, 4>& to, std::chrono::nanoseconds duration,
+                  std::chrono::nanoseconds delay, Ease ease, callback fn) {
+    // The first frame adds the time since the previous one; when idle there
+    // is none, so restart the frame clock here.
+    const auto now = clock::now();
+    if (progress_.empty()) last_ = now;
+    const float seconds = std::max(std::chrono::duration<float>(duration).count(), 1e-6f);
+    const float rate = 1.f / seconds;
+    const float lead = std::chrono::duration<float>(delay).count() + std::chrono::duration<float>(now - last_).count();
+
+    std::uint32_t h;
+    if (!free_.empty()) {
+      h = free_.back();
+      free_.pop_back();
+    } else {
+      h = (std::uint32_t)handles_.size();
+      handles_.emplace_back();
+    }
+    const auto dense = (std::uint32_t)progress_.size();
+    handles_[h].dense = dense;
+    handles_[h].used  = true;
+
+    const poly k = coefficients(ease);
+    progress_.push_back(-lead * rate);
+    rate_.push_back(rate);
+    eased_.push_back(0.f);
+    lo3_.push_back(k.lo3); lo2_.push_back(k.lo2); lo1_.push_back(k.lo1);
+    hi3_.push_back(k.hi3); hi2_.push_back(k.hi2); hi1_.push_back(k.hi1); hi0_.push_back(k.hi0);
+    from_.insert(from_.end(), from.begin(), from.end());
+    to_.insert(to_.end(), to.begin(), to.end());
+    value_.insert(value_.end(), from.begin(), from.end());
+    owner_.push_back(h);
+    callbacks_.push_back(std::move(fn));
+
+    ++stats_.started;
+    frames_.request_frame();
+    return AnimationId{h, handles_[h].gen};
+  }
+
+  // Swap-removes dense entry i and retires its handle.
+  void remove(std::uint32_t i) {
+    const std::uint32_t h = owner_[i];
+    handles_[h].used = false;
+    ++handles_[h].gen;
+    free_.push_back(h);
+
+    const std::size_t last = progress_.size() - 1;
+    if (i != last) {
+      progress_[i] = progress_[last];
+      rate_[i]     = rate_[last];
+      eased_[i]    = eased_[last];
+      lo3_[i] = lo3_[last]; lo2_[i] = lo2_[last]; lo1_[i] = lo1_[last];
+      hi3_[i] = hi3_[last]; hi2_[i] = hi2_[last]; hi1_[i] = hi1_[last]; hi0_[i] = hi0_[last];
+      std::copy_n(&from_[4 * last], 4, &from_[4 * (std::size_t)i]);
+      std::copy_n(&to_[4 * last], 4, &to_[4 * (std::size_t)i]);
+      std::copy_n(&value_[4 * last], 4, &value_[4 * (std::size_t)i]);
+      owner_[i]     = owner_[last];
+      callbacks_[i] = std::move(callbacks_[last]);
+      handles_[owner_[i]].dense = i;
+    }
+    progress_.pop_back();
+    rate_.pop_back();
+    eased_.pop_back();
+    lo3_.pop_back(); lo2_.pop_back(); lo1_.pop_back();
+    hi3_.pop_back(); hi2_.pop_back(); hi1_.pop_back(); hi0_.pop_back();
+    from_.resize(4 * last);
+    to_.resize(4 * last);
+    value_.resize(4 * last);
+    owner_.pop_back();
+    callbacks_.pop_back();
+  }
+
+  core::frame_scheduler frames_;
+  clock::time_point last_{clock::now()};
+
+  // One entry per running tween ([0, size())), four lanes for the values.
+  std::vector<float> progress_, rate_, eased_;
+  std::vector<float> lo3_, lo2_, lo1_, hi3_, hi2_, hi1_, hi0_;
+  std::vector<float> from_, to_, value_;
+  std::vector<std::uint32_t> owner_; // handle index
+  std::vector<callback> callbacks_;
+
+  std::vector<handle> handles_;
+  std::vector<std::uint32_t> free_;
+  std::vector<AnimationId> due_;
+
+  inline_executor inline_pex_;
+  pulse::topic<AnimationFrame> frame_out_;
+  AnimationStats stats_;
+};
+
+// Cancels its animation when destroyed. Belongs to one widget: copies and
+// moves start empty (the callback points at the original), like Widget's
+// host binding.
+class ScopedAnimation {
+public:
+  ScopedAnimation() = default;
+  ScopedAnimation(const ScopedAnimation&) {}
+  ScopedAnimation& operator=(const ScopedAnimation&) { reset(); return *this; }
+  ~ScopedAnimation() { reset(); }
+
+  void assign(Animator& a, AnimationId id) {
+    reset();
+    animator_ = &a;
+    id_ = id;
+  }
+
+  void reset() {
+    if (animator_) animator_->cancel(id_);
+    animator_ = nullptr;
+  }
+
+  bool active() const { return animator_ && animator_->active(id_); }
+
+private:
+  Animator* animator_{nullptr};
+  AnimationId id_{};
+};
+
+} // namespace pulseui::ui
@@ -0,0 +1,281 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include <pulseui/ui/canvas.hpp>
+#include <pulseui/ui/display_list.hpp>
+#include <pulseui/ui/region.hpp>
+
+namespace pulseui::ui {
+
+// Draw calls and the backend state switches they imply: a color change
+// whenever a draw uses a different color than the previous one, a font
+// change whenever a text draw uses a different font than the previous text.
+struct CanvasStats {
+  std::uint64_t clears{};
+  std::uint64_t fills{};
+  std::uint64_t texts{};
+  std::uint64_t images{};
+  std::uint64_t color_changes{};
+  std::uint64_t font_changes{};
+
+  std::uint64_t draws() const { return clears + fills + texts + images; }
+  std::uint64_t state_changes() const { return color_changes + font_changes; }
+};
+
+class StateCounter {
+public:
+  void note(DrawCommand::Kind kind, const Color& c, const Font* f = nullptr) {
+    switch (kind) {
+      case DrawCommand::Clear:    ++stats_.clears; break;
+      case DrawCommand::FillRect: ++stats_.fills; break;
+      case DrawCommand::DrawText: ++stats_.texts; break;
+      case DrawCommand::DrawImage: ++stats_.images; return; // no brush or font
+    }
+    if (!has_color_ || !same(c, color_)) ++stats_.color_changes;
+    color_ = c;
+    has_color_ = true;
+    if (f) {
+      if (!has_font_ || f->size != font_.size) ++stats_.font_changes;
+      font_ = *f;
+      has_font_ = true;
+    }
+  }
+
+  const CanvasStats& stats() const { return stats_; }
+  void reset() { *this = StateCounter{}; }
+
+  static bool same(const Color& a, const Color& b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+  }
+
+private:
+  CanvasStats stats_;
+  Color color_{};
+  Font font_{};
+  bool has_color_{false}, has_font_{false};
+};
+
+// Pass-through canvas that counts calls and state changes; with no target it
+// just counts.
+class CountingCanvas final : public Canvas {
+public:
+  explicit CountingCanvas(Canvas* target = nullptr) : target_(target) {}
+
+  void clear(Color c) override {
+    counter_.note(DrawCommand::Clear, c);
+    if (target_) target_->clear(c);
+  }
+  void fill_rect(Rect r, Color c) override {
+    counter_.note(DrawCommand::FillRect, c);
+    if (target_) target_->fill_rect(r, c);
+  }
+  void draw_text(Point p, std::string_view text, const Font& f, Color c) override {
+    counter_.note(DrawCommand::DrawText, c, &f);
+    if (target_) target_->draw_text(p, text, f, c);
+  }
+  void draw_image(Rect dst, const Image& img, float opacity) override {
+    counter_.note(DrawCommand::DrawImage, Color{});
+    if (target_) target_->draw_image(dst, img, opacity);
+  }
+  TextMetrics measure_text(std::string_view text, const Font& f) override {
+    return target_ ? target_->measure_text(text, f) : Canvas::measure_text(text, f);
+  }
+  const Region* damage() const override { return target_ ? target_->damage() : nullptr; }
+  float dpi_scale() const override { return target_ ? target_->dpi_scale() : 1.f; }
+
+  const CanvasStats& stats() const { return counter_.stats(); }
+  void reset() { counter_.reset(); }
+
+private:
+  Canvas* target_;
+  StateCounter counter_;
+};
+
+struct BatchStats {
+  std::uint64_t commands_in{};
+  std::uint64_t commands_out{};
+  std::uint64_t dropped{};       // covered by a later clear
+  std::uint64_t merged_rects{};  // fills folded into an abutting one
+  std::uint64_t state_changes_in{};
+  std::uint64_t state_changes_out{};
+};
+
+// Buffers a frame's draw calls and hands them to the target canvas grouped by
+// color/font, so backends switch brushes and fonts less often. A command only
+// moves ahead of the ones it does not overlap, so the picture is unchanged.
+// Abutting same-color rects are merged into one; draws before the last clear
+// are dropped.
+//
+//   BatchingCanvas batcher;
+//   win->on_paint([&](Canvas& g){ batcher.paint(g, [&](Canvas& c){ ...draw... }); });
+//
+// Keep the batcher around: its buffers are reused from frame to frame.
+class BatchingCanvas final : public Canvas {
+public:
+  template <class Paint>
+  void paint(Canvas& target, Paint&& paint) {
+    target_ = &target;
+    list_.clear();
+    bounds_.clear();
+    paint(static_cast<Canvas&>(*this));
+    flush();
+    target_ = nullptr;
+  }
+
+  void clear(Color c) override {
+    list_.push_clear(c);
+    bounds_.push_back(Rect{});
+  }
+  void fill_rect(Rect r, Color c) override {
+    if (r.w <= 0 || r.h <= 0) return;
+    list_.push_fill_rect(r, c);
+    bounds_.push_back(r);
+  }
+  void draw_text(Point p, std::string_view text, const Font& f, Color c) override {
+    list_.push_text(p, text, f, c);
+    bounds_.push_back(text_bounds(p, measure_text(text, f), f));
+  }
+  void draw_image(Rect dst, const Image& img, float opacity) override {
+    if (dst.w <= 0 || dst.h <= 0) return;
+    list_.push_image(dst, img, opacity);
+    bounds_.push_back(dst);
+  }
+  TextMetrics measure_text(std::string_view text, const Font& f) override {
+    return target_ ? target_->measure_text(text, f) : Canvas::measure_text(text, f);
+  }
+  const Region* damage() const override { return target_ ? target_->damage() : nullptr; }
+  float dpi_scale() const override { return target_ ? target_->dpi_scale() : 1.f; }
+
+  // Stats of the last frame.
+  const BatchStats& stats() const { return stats_; }
+
+private:
+  // Batches further back than this are not considered, which bounds the
+  // reordering cost per command.
+  static constexpr std::size_t kLookback = 32;
+
+  struct Batch {
+    DrawCommand::Kind kind;
+    Color color;
+    Font font;
+    Rect bounds;
+  };
+
+  // Images have no brush state to share; each one is its own batch.
+  static bool same_state(const Batch& b, const DrawCommand& cmd) {
+    if (cmd.kind == DrawCommand::DrawImage) return false;
+    if (b.kind != cmd.kind || !StateCounter::same(b.color, cmd.color)) return false;
+    return cmd.kind != DrawCommand::DrawText || b.font.size == cmd.font.size;
+  }
+
+  static bool abut(const Rect& a, const Rect& b) {
+    return (a.y == b.y && a.h == b.h && (a.x + a.w == b.x || b.x + b.w == a.x)) ||
+           (a.x == b.x && a.w == b.w && (a.y + a.h == b.y || b.y + b.h == a.y));
+  }
+
+  void flush() {
+    const auto cmds = list_.commands();
+    stats_ = BatchStats{};
+    stats_.commands_in = cmds.size();
+
+    StateCounter before;
+    for (const DrawCommand& cmd : cmds) note(before, cmd);
+    stats_.state_changes_in = before.stats().state_changes();
+
+    // Everything before the last clear is painted over.
+    std::size_t start = 0;
+    for (std::size_t i = cmds.size(); i-- > 0;) {
+      if (cmds[i].kind == DrawCommand::Clear) { start = i; break; }
+    }
+    stats_.dropped = start;
+
+    // Assign each command to the latest batch with the same state that it can
+    // legally join, i.e. it overlaps nothing drawn in the batches after it.
+    batches_.clear(); // members_ keeps its vectors (and their capacity)
+    for (std::size_t i = start; i < cmds.size(); ++i) {
+      const DrawCommand& cmd = cmds[i];
+      const Rect& r = bounds_[i];
+      std::size_t target = batches_.size();
+      if (cmd.kind != DrawCommand::Clear) {
+        const std::size_t stop = batches_.size() > kLookback ? batches_.size() - kLookback : 0;
+        for (std::size_t b = batches_.size(); b-- > stop;) {
+          if (same_state(batches_[b], cmd)) { target = b; break; }
+          if (batches_[b].kind == DrawCommand::Clear || overlaps(batches_[b], r)) break;
+        }
+      }
+      if (target == batches_.size()) {
+        batches_.push_back(Batch{cmd.kind, cmd.color, cmd.font, r});
+        if (members_.size() < batches_.size()) members_.emplace_back();
+        members_[target].clear();
+      } else {
+        batches_[target].bounds = unite(batches_[target].bounds, r);
+      }
+      members_[target].push_back((std::uint32_t)i);
+    }
+
+    StateCounter after;
+    for (std::size_t b = 0; b < batches_.size(); ++b) {
+      const Batch& batch = batches_[b];
+      if (batch.kind == DrawCommand::FillRect) {
+        merge_rects(members_[b]);
+        for (const Rect& r : rects_) {
+          after.note(DrawCommand::FillRect, batch.color);
+          target_->fill_rect(r, batch.color);
+        }
+        continue;
+      }
+      for (std::uint32_t i : members_[b]) {
+        const DrawCommand& cmd = cmds[i];
+        note(after, cmd);
+        if (cmd.kind == DrawCommand::Clear) {
+          target_->clear(cmd.color);
+        } else if (cmd.kind == DrawCommand::DrawImage) {
+          target_->draw_image(cmd.rect, list_.image(cmd.image), cmd.color.a);
+        } else {
+          target_->draw_text(Point{cmd.rect.x, cmd.rect.y}, list_.text().view(cmd.text), cmd.font, cmd.color);
+        }
+      }
+    }
+    stats_.commands_out = after.stats().draws();
+    stats_.state_changes_out = after.stats().state_changes();
+  }
+
+  static void note(StateCounter& counter, const DrawCommand& cmd) {
+    counter.note(cmd.kind, cmd.color, cmd.kind == DrawCommand::DrawText ? &cmd.font : nullptr);
+  }
+
+  bool overlaps(const Batch& b, const Rect& r) const {
+    if (!intersects(b.bounds, r)) return false;
+    for (std::uint32_t i : members_[&b - batches_.data()]) {
+      if (intersects(bounds_[i], r)) return true;
+    }
+    return false;
+  }
+
+  // Rects of one batch, with each new rect merged into the previous one while
+  // they abut: a row of cells becomes a strip, equal strips become a block.
+  void merge_rects(const std::vector<std::uint32_t>& ids) {
+    rects_.clear();
+    for (std::uint32_t i : ids) {
+      rects_.push_back(bounds_[i]);
+      while (rects_.size() >= 2 && abut(rects_[rects_.size() - 2], rects_.back())) {
+        const Rect last = rects_.back();
+        rects_.pop_back();
+        rects_.back() = unite(rects_.back(), last);
+        ++stats_.merged_rects;
+      }
+    }
+  }
+
+  Canvas* target_{nullptr};
+  DisplayList list_;
+  std::vector<Rect> bounds_;  // per command; fills: the rect itself
+  std::vector<Batch> batches_;
+  std::vector<std::vector<std::uint32_t>> members_; // command indices per batch
+  std::vector<Rect> rects_;
+  BatchStats stats_;
+};
+
+} // namespace pulseui::ui
@@ -1,9 +1,13 @@
 #pragma once
+#include <chrono>
 #include <string>
 #include <functional>
 #include <vector>
+#include <pulseui/ui/animation.hpp>
 #include <pulseui/ui/input.hpp>
 #include <pulseui/ui/canvas.hpp>
+#include <pulseui/ui/display_list.hpp>
+#include <pulseui/ui/widget.hpp>
 
 namespace pulseui::ui {
 
@@ -16,42 +20,117 @@ struct ButtonStyle {
   Color fg        {1,1,1,1};
   Font  font{16.f};
   float padding_px = 12.f;
+  // Background fade between states, when the button has an Animator.
+  std::chrono::nanoseconds transition{std::chrono::milliseconds(120)};
+  Ease transition_ease{Ease::OutCubic};
 };
 
-class Button {
+class Button : public Widget {
 public:
   Button(Rect rect, std::string text)
     : rect_(rect), text_(std::move(text)) {}
 
-  Button& set_rect(Rect r)         { rect_ = r; return *this; }
-  Button& set_text(std::string t)  { text_ = std::move(t); return *this; }
-  Button& set_style(ButtonStyle s) { style_ = std::move(s); return *this; }
+  Button& set_rect(Rect r) {
+    const Rect old = rect_;
+    if (r.x == old.x && r.y == old.y && r.w == old.w && r.h == old.h) return *this;
+    rect_ = r;
+    // A pure move (e.g. scrolling) shifts the recorded commands instead of re-recording.
+    if (r.w == old.w && r.h == old.h) commands_.translate(r.x - old.x, r.y - old.y);
+    else dirty_ = true;
+    bounds_changed(old);
+    return *this;
+  }
+  Button& set_text(std::string t)  { text_ = std::move(t); dirty_ = true; return *this; }
+  Button& set_style(ButtonStyle s) { style_ = std::move(s); dirty_ = true; return *this; }
+  // Fades the background on hover/press changes. Without an animator (or
+  // with a zero style transition) the colors switch at once. Repaints go
+  // through the host, so the button should be in a WidgetContainer.
+  Button& set_animator(Animator* a) { animator_ = a; fade_.reset(); dirty_ = true; return *this; }
+
+  const Rect& rect() const { return rect_; }
+  Rect bounds() const override { return rect_; }
+  void set_bounds(Rect r) override { set_rect(r); }
 
   void on_click(std::function<void()> fn) { click_handlers_.push_back(std::move(fn)); }
 
-  void handle_mouse_move(Point p) {
+  // The handlers return true when the button's look changed, i.e. rect()
+  // needs repainting: `if (btn.handle_mouse_move(p)) win->invalidate(btn.rect());`
+  bool handle_mouse_move(Point p) override {
+    const Color shown = shown_bg();
     hovered_ = contains(p);
-    if (hovered_ != last_hovered_) last_hovered_ = hovered_;
+    if (hovered_ == last_hovered_) return false;
+    last_hovered_ = hovered_;
+    state_changed(shown);
+    return true;
+  }
+
+  bool handle_mouse_down(Point p, MouseButton b) override {
+    if (b != MouseButton::Left) return false;
+    const Color shown = shown_bg();
+    const bool was_pressed = pressed_;
+    pressed_ = contains(p);
+    if (pressed_ == was_pressed) return false;
+    state_changed(shown);
+    return true;
   }
 
-  void handle_mouse_down(Point p, MouseButton b) {
-    if (b == MouseButton::Left) {
-      pressed_ = contains(p);
+  bool handle_mouse_up(Point p, MouseButton b) override {
+    if (b != MouseButton::Left) return false;
+    const Color shown = shown_bg();
+    const bool was_pressed = pressed_;
+    pressed_ = false;
+    if (!was_pressed) return false;
+    state_changed(shown);
+    if (contains(p)) {
+      for (auto &fn : click_handlers_) if (fn) fn();
     }
+    return true;
+  }
+
+  // WidgetContainer calls this when the pointer moves to another widget.
+  bool handle_mouse_leave() override {
+    if (!hovered_) return false;
+    const Color shown = shown_bg();
+    hovered_ = last_hovered_ = false;
+    state_changed(shown);
+    return true;
   }
 
-  void handle_mouse_up(Point p, MouseButton b) {
-    if (b == MouseButton::Left) {
-      const bool was_pressed = pressed_;
-      pressed_ = false;
-      if (was_pressed && contains(p)) {
-        for (auto &fn : click_handlers_) if (fn) fn();
-      }
+  // Replays the commands recorded for the current state; re-records only
+  // after the rect, text, style, hover or pressed state changed.
+  void paint(Canvas& g) override {
+    if (!g.needs_paint(rect_)) return;
+    if (dirty_) {
+      commands_.clear();
+      RecordingCanvas rec(commands_, &g);
+      record(rec);
+      dirty_ = false;
     }
+    commands_.replay(g);
   }
 
-  void paint(Canvas& g) {
-    const Color bg = pressed_ ? style_.bg_down : (hovered_ ? style_.bg_hover : style_.bg_normal);
+private:
+  Color target_bg() const { return pressed_ ? style_.bg_down : (hovered_ ? style_.bg_hover : style_.bg_normal); }
+  Color shown_bg() const { return fade_.active() ? bg_ : target_bg(); }
+
+  // Fades from the color on screen to the new state's color; every step
+  // re-records and asks the host for a repaint.
+  void state_changed(const Color& shown) {
+    dirty_ = true;
+    if (!animator_ || style_.transition.count() <= 0) return;
+    bg_ = shown;
+    const AnimationId id = animator_->start(
+      Tween<Color>{shown, target_bg(), style_.transition, style_.transition_ease},
+      [this](const Color& c) {
+        bg_ = c;
+        dirty_ = true;
+        request_paint();
+      });
+    fade_.assign(*animator_, id);
+  }
+
+  void record(Canvas& g) const {
+    const Color bg = shown_bg();
     g.fill_rect(rect_, bg);
 
     if (pressed_) {
@@ -59,11 +138,11 @@ public:
       g.fill_rect(Rect{rect_.x, rect_.y + rect_.h - 1, rect_.w, 1}, mul(bg, 1.2f));
     }
 
-    const float baseline = rect_.y + rect_.h * 0.5f - style_.font.size * 0.35f;
-    g.draw_text(Point{rect_.x + style_.padding_px, baseline}, text_, style_.font, style_.fg);
+    const TextMetrics m = g.measure_text(text_, style_.font);
+    const float top = rect_.y + (rect_.h - m.height()) * 0.5f;
+    g.draw_text(Point{rect_.x + style_.padding_px, top}, text_, style_.font, style_.fg);
   }
 
-private:
   bool contains(Point p) const {
     return p.x >= rect_.x && p.x <= rect_.x + rect_.w &&
            p.y >= rect_.y && p.y <= rect_.y + rect_.h;
@@ -75,7 +154,13 @@ private:
   ButtonStyle style_{};
 
   bool hovered_{false}, last_hovered_{false}, pressed_{false};
+  Animator* animator_{nullptr};
+  ScopedAnimation fade_; // cancelled with the button; copies start without it
+  Color bg_{};           // background while fade_ runs
   std::vector<std::function<void()>> click_handlers_;
+
+  DisplayList commands_;
+  bool dirty_{true};
 };
 
 } // namespace pulseui::ui
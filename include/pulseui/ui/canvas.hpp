@@ -1,14 +1,84 @@
 #pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <string>
 #include <string_view>
+#include <utility>
+#include <pulseui/core/frame_arena.hpp>
+#include <pulseui/detail/format.hpp>
 #include <pulseui/ui/input.hpp>
+#include <pulseui/ui/region.hpp>
 
 namespace pulseui::ui {
   struct Font { float size = 14.f; /* future: family/weight */ };
+  class Image; // pulseui/ui/image.hpp
+
+  // Extents of a line of text drawn with draw_text at p: it covers
+  // [p.x, p.x + width) x [p.y, p.y + ascent + descent), baseline at p.y + ascent.
+  struct TextMetrics {
+    float width{};
+    float ascent{};
+    float descent{};
+    float height() const { return ascent + descent; }
+  };
+
+  // Conservative pixel bounds of a draw_text at p: glyphs may overhang
+  // their advance box a little.
+  inline Rect text_bounds(Point p, const TextMetrics& m, const Font& f) {
+    const float pad = f.size * 0.25f;
+    return Rect{p.x - pad, p.y - pad, m.width + 2 * pad, m.height() + 2 * pad};
+  }
+
+  // Scratch memory of the frame being painted, shared by the windows of the
+  // UI thread. Windows reset it after every paint callback returns.
+  inline core::frame_arena& paint_arena() {
+    static core::frame_arena arena;
+    return arena;
+  }
 
   struct Canvas {
     virtual ~Canvas() = default;
     virtual void clear(Color c) = 0;
     virtual void fill_rect(Rect r, Color c) = 0;
     virtual void draw_text(Point p, std::string_view text, const Font& f, Color c) = 0;
+    // Scales img into dst; opacity multiplies its alpha. Decoded surfaces
+    // come from ui::surface_cache(). Backends without images draw nothing.
+    virtual void draw_image(Rect /*dst*/, const Image& /*img*/, float /*opacity*/) {}
+
+    // Device pixels per unit, e.g. 2 on a Retina display; picks image mip levels.
+    virtual float dpi_scale() const { return 1.f; }
+
+    // Formats args into the paint arena and draws the result, so per-frame
+    // labels need no heap string:
+    //   g.draw_textf({34, 110}, Font{20.f}, fg, "Counter: {}", state.counter);
+    // std::format syntax; see detail/format.hpp for the fallback without <format>.
+    template <class... Args>
+    void draw_textf(Point p, const Font& f, Color c, detail::format_string<Args...> fmt, Args&&... args) {
+      std::pmr::string text(&arena());
+      text.reserve(64);
+      detail::format_append(text, fmt, std::forward<Args>(args)...);
+      draw_text(p, text, f, c);
+    }
+
+    // Memory for data that only lives until the end of this paint, e.g.
+    // std::pmr::vector<Rect> v(&g.arena()). Never hold on to it across frames.
+    core::frame_arena& arena() const { return paint_arena(); }
+
+    // Backends measure with the font they draw with; the default is an
+    // approximation (half an em per code point).
+    virtual TextMetrics measure_text(std::string_view text, const Font& f) {
+      std::size_t n = 0;
+      for (unsigned char ch : text) n += (ch & 0xC0) != 0x80; // skip UTF-8 continuation bytes
+      return TextMetrics{f.size * 0.5f * (float)n, f.size * 0.8f, f.size * 0.2f};
+    }
+
+    // Area being repainted; nullptr means the whole surface. Drawing outside
+    // it is clipped away, so widgets can skip it (see needs_paint).
+    virtual const Region* damage() const { return nullptr; }
+
+    bool needs_paint(Rect r) const {
+      const Region* d = damage();
+      return !d || d->intersects(r);
+    }
   };
 }
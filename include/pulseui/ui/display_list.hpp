@@ -0,0 +1,172 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <pulseui/ui/canvas.hpp>
+#include <pulseui/ui/image.hpp>
+
+namespace pulseui::ui {
+
+// Interns strings into one contiguous buffer. Handles stay valid until clear().
+class TextPool {
+public:
+  using handle = std::uint32_t;
+
+  handle intern(std::string_view s) {
+    const std::size_t h = std::hash<std::string_view>{}(s);
+    auto [it, end] = index_.equal_range(h);
+    for (; it != end; ++it) {
+      if (view(it->second) == s) return it->second;
+    }
+    const auto id = (handle)entries_.size();
+    entries_.push_back({(std::uint32_t)chars_.size(), (std::uint32_t)s.size()});
+    chars_.append(s);
+    index_.emplace(h, id);
+    return id;
+  }
+
+  std::string_view view(handle h) const {
+    const entry& e = entries_[h];
+    return std::string_view(chars_).substr(e.offset, e.size);
+  }
+
+  void clear() {
+    chars_.clear();
+    entries_.clear();
+    index_.clear();
+  }
+
+  std::size_t size()  const { return entries_.size(); }
+  std::size_t bytes() const { return chars_.size(); }
+
+private:
+  struct entry { std::uint32_t offset, size; };
+  std::string chars_;
+  std::vector<entry> entries_;
+  std::unordered_multimap<std::size_t, handle> index_;
+};
+
+struct DrawCommand {
+  enum Kind : std::uint8_t { Clear, FillRect, DrawText, DrawImage } kind;
+  Rect  rect{};            // DrawText: x/y hold the text origin
+  Color color{};           // DrawImage: a holds the opacity
+  Font  font{};
+  TextPool::handle text{}; // DrawText only
+  std::uint32_t image{};   // DrawImage only, index into DisplayList::image()
+};
+
+// Flat, replayable record of Canvas calls. clear() keeps the command storage
+// and the interned text, so re-recording a similar frame does not allocate.
+class DisplayList {
+public:
+  void clear() {
+    commands_.clear();
+    images_.clear();
+    // Keep interned strings across re-records, but don't let a label that
+    // changes every frame grow the pool without bound.
+    if (text_.bytes() > kMaxPooledTextBytes) text_.clear();
+  }
+
+  void push_clear(Color c) { commands_.push_back({DrawCommand::Clear, {}, c, {}, 0}); }
+  void push_fill_rect(Rect r, Color c) { commands_.push_back({DrawCommand::FillRect, r, c, {}, 0}); }
+  void push_text(Point p, std::string_view s, const Font& f, Color c) {
+    commands_.push_back({DrawCommand::DrawText, Rect{p.x, p.y, 0, 0}, c, f, text_.intern(s)});
+  }
+
+  void push_image(Rect dst, const Image& img, float opacity) {
+    commands_.push_back({DrawCommand::DrawImage, dst, Color{1, 1, 1, opacity}, {}, 0, (std::uint32_t)images_.size()});
+    images_.push_back(img);
+  }
+
+  // Moves every recorded command by (dx, dy).
+  void translate(float dx, float dy) {
+    for (DrawCommand& cmd : commands_) {
+      cmd.rect.x += dx;
+      cmd.rect.y += dy;
+    }
+  }
+
+  void replay(Canvas& g) const {
+    for (const DrawCommand& cmd : commands_) {
+      switch (cmd.kind) {
+        case DrawCommand::Clear:    g.clear(cmd.color); break;
+        case DrawCommand::FillRect: g.fill_rect(cmd.rect, cmd.color); break;
+        case DrawCommand::DrawText:
+          g.draw_text(Point{cmd.rect.x, cmd.rect.y}, text_.view(cmd.text), cmd.font, cmd.color);
+          break;
+        case DrawCommand::DrawImage: g.draw_image(cmd.rect, images_[cmd.image], cmd.color.a); break;
+      }
+    }
+  }
+
+  std::span<const DrawCommand> commands() const { return commands_; }
+  const TextPool& text() const { return text_; }
+  const Image& image(std::uint32_t i) const { return images_[i]; }
+  bool empty() const { return commands_.empty(); }
+  std::size_t size() const { return commands_.size(); }
+
+private:
+  static constexpr std::size_t kMaxPooledTextBytes = 16 * 1024;
+
+  std::vector<DrawCommand> commands_;
+  TextPool text_;
+  std::vector<Image> images_; // handles only; pixels stay in the surface cache
+};
+
+// Canvas that appends every call to a DisplayList instead of drawing.
+class RecordingCanvas final : public Canvas {
+public:
+  // measure_text is forwarded to `measure` (the canvas the list will be
+  // replayed on) when given, so recorded layout uses the real font metrics.
+  explicit RecordingCanvas(DisplayList& out, Canvas* measure = nullptr)
+    : out_(out), measure_(measure) {}
+
+  void clear(Color c) override { out_.push_clear(c); }
+  void fill_rect(Rect r, Color c) override { out_.push_fill_rect(r, c); }
+  void draw_text(Point p, std::string_view text, const Font& f, Color c) override {
+    out_.push_text(p, text, f, c);
+  }
+  void draw_image(Rect dst, const Image& img, float opacity) override { out_.push_image(dst, img, opacity); }
+  TextMetrics measure_text(std::string_view text, const Font& f) override {
+    return measure_ ? measure_->measure_text(text, f) : Canvas::measure_text(text, f);
+  }
+  float dpi_scale() const override { return measure_ ? measure_->dpi_scale() : 1.f; }
+
+private:
+  DisplayList& out_;
+  Canvas* measure_;
+};
+
+// Keeps the output of a paint function and replays it until mark_dirty().
+//
+//   RetainedPaint panel;
+//   win->on_paint([&](Canvas& g){ panel.paint(g, [&](Canvas& rec){ ...draw... }); });
+//   model$.subscribe([&](auto&){ panel.mark_dirty(); win->invalidate(); });
+class RetainedPaint {
+public:
+  void mark_dirty() { dirty_ = true; }
+  bool dirty() const { return dirty_; }
+
+  template <class Record>
+  void paint(Canvas& g, Record&& record) {
+    if (dirty_) {
+      list_.clear();
+      RecordingCanvas rec(list_, &g);
+      record(static_cast<Canvas&>(rec));
+      dirty_ = false;
+    }
+    list_.replay(g);
+  }
+
+  const DisplayList& list() const { return list_; }
+
+private:
+  DisplayList list_;
+  bool dirty_{true};
+};
+
+} // namespace pulseui::ui
@@ -0,0 +1,154 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+#include <pulseui/detail/image_decode.hpp>
+#include <pulseui/detail/mapped_file.hpp>
+
+namespace pulseui::ui {
+
+// Decoded pixels: straight-alpha RGBA8 words (R in the low byte), row-major.
+// The pixels may live in a memory-mapped file (zero-copy decode) or in a
+// buffer owned by the surface; `owner` keeps either alive.
+struct Surface {
+  int width{0}, height{0};
+  std::size_t stride{0}; // in pixels
+  const std::uint32_t* pixels{nullptr};
+  std::shared_ptr<const void> owner;
+  // Backend-prepared copy (GDI bitmap, CGImage), made on first draw and
+  // dropped with the surface.
+  mutable std::shared_ptr<void> native;
+
+  const std::uint32_t* row(int y) const { return pixels + (std::size_t)y * stride; }
+  std::size_t bytes() const { return (std::size_t)width * (std::size_t)height * 4; }
+
+  static std::shared_ptr<Surface> allocate(int w, int h) {
+    auto buf = std::make_shared<std::vector<std::uint32_t>>((std::size_t)w * (std::size_t)h);
+    auto s = std::make_shared<Surface>();
+    s->width = w;
+    s->height = h;
+    s->stride = (std::size_t)w;
+    s->pixels = buf->data();
+    s->owner = std::move(buf);
+    return s;
+  }
+};
+
+// Handle to an image source: a mapped file, a memory block or pixels. Cheap
+// to copy; loading only reads the header, pixels are decoded when a canvas
+// first draws the image (see SurfaceCache). Supported: binary PPM (P6), PAM
+// (P7, RGB or RGB_ALPHA, the latter zero-copy) and QOI.
+//
+//   const ui::Image icon = ui::Image::load("icons/ok.qoi");
+//   win->on_paint([&](Canvas& g){ g.draw_image(Rect{8, 8, 24, 24}, icon, 1.f); });
+class Image {
+public:
+  Image() = default;
+
+  // Empty Image if the file is missing or not in a supported format.
+  static Image load(const std::string& path) {
+    auto file = detail::mapped_file::open(path);
+    if (!file) return {};
+    const std::uint8_t* data = file->data();
+    const std::size_t size = file->size();
+    return from_memory(std::span<const std::uint8_t>(data, size), std::move(file));
+  }
+
+  // Encoded bytes kept alive by `owner` (nullptr: caller keeps them alive).
+  static Image from_memory(std::span<const std::uint8_t> bytes, std::shared_ptr<const void> owner = nullptr) {
+    const detail::image_header h = detail::read_image_header(bytes.data(), bytes.size());
+    if (h.format == detail::image_format::none) return {};
+    auto src = std::make_shared<source>();
+    src->header = h;
+    src->bytes = bytes;
+    src->owner = std::move(owner);
+    return Image(std::move(src));
+  }
+
+  // Straight-alpha RGBA8 pixels, R in the low byte; no decoding needed.
+  static Image from_pixels(int width, int height, std::vector<std::uint32_t> pixels) {
+    if (width <= 0 || height <= 0 || pixels.size() < (std::size_t)width * (std::size_t)height) return {};
+    auto s = std::make_shared<Surface>();
+    auto buf = std::make_shared<std::vector<std::uint32_t>>(std::move(pixels));
+    s->width = width;
+    s->height = height;
+    s->stride = (std::size_t)width;
+    s->pixels = buf->data();
+    s->owner = std::move(buf);
+    auto src = std::make_shared<source>();
+    src->header.width = width;
+    src->header.height = height;
+    src->decoded = std::move(s);
+    return Image(std::move(src));
+  }
+
+  explicit operator bool() const { return (bool)src_; }
+  int width() const { return src_ ? src_->header.width : 0; }
+  int height() const { return src_ ? src_->header.height : 0; }
+  // Unique per source; the cache key.
+  std::uint64_t id() const { return src_ ? src_->id : 0; }
+
+  // Full-size pixels. Uncompressed RGBA points into the source bytes when
+  // they are 4-byte aligned; everything else is decoded into a new buffer.
+  // nullptr for an empty image or corrupt data.
+  std::shared_ptr<const Surface> decode() const {
+    if (!src_) return nullptr;
+    if (src_->decoded) return src_->decoded;
+    const detail::image_header& h = src_->header;
+    const std::uint8_t* first = src_->bytes.data() + h.offset;
+    const std::size_t count = (std::size_t)h.width * (std::size_t)h.height;
+
+    if (h.format == detail::image_format::pam_rgba && reinterpret_cast<std::uintptr_t>(first) % alignof(std::uint32_t) == 0) {
+      auto s = std::make_shared<Surface>();
+      s->width = h.width;
+      s->height = h.height;
+      s->stride = (std::size_t)h.width;
+      s->pixels = reinterpret_cast<const std::uint32_t*>(first);
+      s->owner = src_; // keeps the bytes (and their mapping) alive
+      return s;
+    }
+
+    auto s = Surface::allocate(h.width, h.height);
+    auto* out = const_cast<std::uint32_t*>(s->pixels);
+    switch (h.format) {
+      case detail::image_format::pam_rgba: detail::copy_rgba(first, count, out); break;
+      case detail::image_format::pam_rgb:
+      case detail::image_format::ppm:      detail::expand_rgb(first, count, out); break;
+      case detail::image_format::qoi:
+        if (!detail::decode_qoi(src_->bytes.data(), src_->bytes.size(), h, out)) return nullptr;
+        break;
+      case detail::image_format::none: return nullptr;
+    }
+    return s;
+  }
+
+  bool zero_copy() const {
+    return src_ && src_->header.format == detail::image_format::pam_rgba &&
+           reinterpret_cast<std::uintptr_t>(src_->bytes.data() + src_->header.offset) % alignof(std::uint32_t) == 0;
+  }
+
+private:
+  struct source {
+    std::uint64_t id{next_id()};
+    detail::image_header header;
+    std::span<const std::uint8_t> bytes;
+    std::shared_ptr<const void> owner;
+    std::shared_ptr<const Surface> decoded; // from_pixels only
+  };
+
+  static std::uint64_t next_id() {
+    static std::atomic<std::uint64_t> n{0};
+    return n.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  explicit Image(std::shared_ptr<const source> s) : src_(std::move(s)) {}
+
+  std::shared_ptr<const source> src_;
+};
+
+} // namespace pulseui::ui
@@ -0,0 +1,176 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <pulseui/core/profiler.hpp>
+#include <pulseui/ui/image.hpp>
+#include <pulseui/ui/input.hpp>
+
+namespace pulseui::ui {
+
+struct ImageCacheStats {
+  std::uint64_t hits{};
+  std::uint64_t misses{};
+  std::uint64_t decodes{};   // full-size surfaces made from the source
+  std::uint64_t mips{};      // half-size levels made from the level above
+  std::uint64_t evictions{};
+  std::size_t   entries{};
+  std::size_t   bytes{};
+  std::size_t   budget{};
+};
+
+// LRU cache of decoded surfaces keyed by (image, mip level), bounded by a
+// byte budget. Level 0 is the full image; level n is half the size of level
+// n-1, box-filtered from it. A draw picks the smallest level that still
+// covers the destination in device pixels (rect size x Canvas::dpi_scale()),
+// so a 256px icon drawn at 24px on a 2x display keeps only its 64px level
+// resident. Single-threaded: shared by the canvases of the UI thread.
+class SurfaceCache {
+public:
+  using SurfacePtr = std::shared_ptr<const Surface>;
+
+  explicit SurfaceCache(std::size_t budget_bytes = std::size_t(32) << 20) { stats_.budget = budget_bytes; }
+
+  SurfaceCache(const SurfaceCache&) = delete;
+  SurfaceCache& operator=(const SurfaceCache&) = delete;
+
+  // Mip level of an image of w x h for a destination of dst_w x dst_h device pixels.
+  static int level_for(int w, int h, float dst_w, float dst_h) {
+    int level = 0;
+    while (level < kMaxLevel) {
+      const int nw = w >> (level + 1), nh = h >> (level + 1);
+      if (nw < 1 || nh < 1 || (float)nw < dst_w || (float)nh < dst_h) break;
+      ++level;
+    }
+    return level;
+  }
+
+  // Surface for drawing img into dst (logical units) at the given dpi scale.
+  SurfacePtr get(const Image& img, Rect dst, float dpi_scale) {
+    if (!img) return nullptr;
+    return get(img, level_for(img.width(), img.height(), std::abs(dst.w) * dpi_scale, std::abs(dst.h) * dpi_scale));
+  }
+
+  // Decodes (level 0) or downsamples (level n) on a miss. The returned
+  // surface stays valid after eviction for as long as it is held.
+  SurfacePtr get(const Image& img, int level) {
+    if (!img) return nullptr;
+    const Key key{img.id(), level};
+    if (auto it = index_.find(key); it != index_.end()) {
+      ++stats_.hits;
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return it->second->surface;
+    }
+    ++stats_.misses;
+
+    SurfacePtr s;
+    if (level == 0) {
+      PULSEUI_PROFILE_SCOPE("image.decode");
+      s = img.decode();
+      ++stats_.decodes;
+    } else {
+      SurfacePtr above = get(img, level - 1);
+      if (!above) return nullptr;
+      PULSEUI_PROFILE_SCOPE("image.mip");
+      s = downsample(*above);
+      ++stats_.mips;
+    }
+    if (!s) return nullptr;
+
+    lru_.push_front(Entry{key, s, s->bytes() + kEntryOverhead});
+    index_.emplace(key, lru_.begin());
+    stats_.bytes += lru_.front().bytes;
+    trim();
+    return s;
+  }
+
+  void set_budget(std::size_t bytes) { stats_.budget = bytes; trim(); }
+
+  void clear() {
+    index_.clear();
+    lru_.clear();
+    stats_.bytes = 0;
+    stats_.entries = 0;
+  }
+
+  const ImageCacheStats& stats() const { return stats_; }
+
+private:
+  static constexpr int kMaxLevel = 12;
+  static constexpr std::size_t kEntryOverhead = 128; // list + hash node + Surface
+
+  struct Key {
+    std::uint64_t image;
+    int level;
+    bool operator==(const Key&) const = default;
+  };
+  struct KeyHash {
+    std::size_t operator()(const Key& k) const noexcept {
+      return std::hash<std::uint64_t>{}(k.image * 16 + (std::uint64_t)k.level);
+    }
+  };
+  struct Entry {
+    Key key;
+    SurfacePtr surface;
+    std::size_t bytes;
+  };
+
+  // Half size, 2x2 box filter weighted by alpha so that transparent pixels
+  // do not darken the edges.
+  static SurfacePtr downsample(const Surface& src) {
+    const int w = std::max(1, src.width / 2), h = std::max(1, src.height / 2);
+    auto out = Surface::allocate(w, h);
+    auto* dst = const_cast<std::uint32_t*>(out->pixels);
+    for (int y = 0; y < h; ++y) {
+      const std::uint32_t* r0 = src.row(std::min(2 * y, src.height - 1));
+      const std::uint32_t* r1 = src.row(std::min(2 * y + 1, src.height - 1));
+      for (int x = 0; x < w; ++x) {
+        const int x0 = std::min(2 * x, src.width - 1), x1 = std::min(2 * x + 1, src.width - 1);
+        const std::uint32_t px[4] = {r0[x0], r0[x1], r1[x0], r1[x1]};
+        std::uint32_t sr = 0, sg = 0, sb = 0, sa = 0;
+        for (std::uint32_t p : px) {
+          const std::uint32_t a = p >> 24;
+          sr += (p & 0xFF) * a;
+          sg += ((p >> 8) & 0xFF) * a;
+          sb += ((p >> 16) & 0xFF) * a;
+          sa += a;
+        }
+        std::uint32_t v = 0;
+        if (sa) {
+          v = (sr + sa / 2) / sa | ((sg + sa / 2) / sa) << 8 | ((sb + sa / 2) / sa) << 16 | ((sa + 2) / 4) << 24;
+        }
+        dst[(std::size_t)y * w + x] = v;
+      }
+    }
+    return out;
+  }
+
+  // Always keeps the newest entry, even when it alone exceeds the budget.
+  void trim() {
+    while (stats_.bytes > stats_.budget && lru_.size() > 1) {
+      Entry& e = lru_.back();
+      index_.erase(e.key);
+      stats_.bytes -= e.bytes;
+      lru_.pop_back();
+      ++stats_.evictions;
+    }
+    stats_.entries = lru_.size();
+  }
+
+  std::list<Entry> lru_;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+  ImageCacheStats stats_;
+};
+
+// Shared by all canvases of the UI thread.
+inline SurfaceCache& surface_cache() {
+  static SurfaceCache cache;
+  return cache;
+}
+
+} // namespace pulseui::ui
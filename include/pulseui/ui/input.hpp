@@ -1,4 +1,5 @@
 #pragma once
+#include <chrono>
 #include <cstdint>
 
 namespace pulseui::ui {
@@ -12,5 +13,13 @@ namespace pulseui::ui {
     Point pos{};
     int keycode{};
     float scrollY{};
+    std::uint64_t timestamp{}; // monotonic nanoseconds, see input_timestamp()
+    std::uint32_t coalesced{}; // raw events merged into this one (InputQueue)
   };
+
+  // Clock used by the backends to stamp InputEvent::timestamp.
+  inline std::uint64_t input_timestamp() {
+    return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
 }
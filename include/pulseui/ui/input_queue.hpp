@@ -0,0 +1,85 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+#include <pulseui/ui/input.hpp>
+
+namespace pulseui::ui {
+
+struct InputQueueStats {
+  std::uint64_t received{};  // raw events pushed
+  std::uint64_t delivered{}; // events handed out after coalescing
+  std::uint64_t batches{};   // flushes that delivered something
+};
+
+// Per-window input buffer, flushed once per frame. Consecutive MouseMove
+// events collapse into the latest one and consecutive Scroll events add up
+// their deltas; everything else is kept in order. Backend independent and
+// single-threaded (the UI thread pushes and flushes).
+class InputQueue {
+public:
+  // With keep_move_history, every raw MouseMove of the pending batch stays
+  // available through move_history() (drawing tools want the full path).
+  explicit InputQueue(bool keep_move_history = false) : keep_history_(keep_move_history) {}
+
+  void set_keep_move_history(bool on) { keep_history_ = on; }
+
+  void push(const InputEvent& e) {
+    ++stats_.received;
+    if (e.type == InputEvent::MouseMove && keep_history_) history_.push_back(e);
+
+    if (!pending_.empty()) {
+      InputEvent& last = pending_.back();
+      if (last.type == e.type && e.type == InputEvent::MouseMove) {
+        const std::uint32_t n = last.coalesced;
+        last = e;
+        last.coalesced = n + 1;
+        return;
+      }
+      if (last.type == e.type && e.type == InputEvent::Scroll) {
+        last.scrollY  += e.scrollY;
+        last.pos       = e.pos;
+        last.timestamp = e.timestamp;
+        ++last.coalesced;
+        return;
+      }
+    }
+    pending_.push_back(e);
+    pending_.back().coalesced = 1;
+  }
+
+  bool empty() const { return pending_.empty(); }
+  std::span<const InputEvent> pending() const { return pending_; }
+  std::span<const InputEvent> move_history() const { return history_; }
+
+  // Hands the coalesced batch to f(std::span<const InputEvent>) and empties
+  // the queue. Events pushed from inside f go into the next batch.
+  template <class F>
+  bool flush(F&& f) {
+    if (pending_.empty()) { history_.clear(); return false; }
+    std::swap(pending_, delivering_);
+    std::swap(history_, delivering_history_);
+    ++stats_.batches;
+    stats_.delivered += delivering_.size();
+    f(std::span<const InputEvent>(delivering_));
+    delivering_.clear();
+    delivering_history_.clear();
+    return true;
+  }
+
+  // During flush(), the raw moves behind the batch being delivered.
+  std::span<const InputEvent> delivered_move_history() const { return delivering_history_; }
+
+  void clear() { pending_.clear(); history_.clear(); }
+
+  const InputQueueStats& stats() const { return stats_; }
+
+private:
+  bool keep_history_;
+  std::vector<InputEvent> pending_, delivering_;
+  std::vector<InputEvent> history_, delivering_history_;
+  InputQueueStats stats_;
+};
+
+} // namespace pulseui::ui
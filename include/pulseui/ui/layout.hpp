@@ -1,6 +1,344 @@
 #pragma once
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
 #include <pulseui/ui/input.hpp>
+
 namespace pulseui::ui {
-  // placeholder for future layout abstractions
-  struct Constraints { float w, h; };
-}
+
+struct Size {
+  float w{}, h{};
+  bool operator==(const Size&) const = default;
+};
+
+struct Constraints {
+  static constexpr float kUnbounded = std::numeric_limits<float>::infinity();
+
+  float min_w{0}, min_h{0};
+  float max_w{kUnbounded}, max_h{kUnbounded};
+
+  static Constraints tight(Size s) { return {s.w, s.h, s.w, s.h}; }
+  static Constraints loose(Size s) { return {0, 0, s.w, s.h}; }
+
+  Size constrain(Size s) const {
+    return {std::max(min_w, std::min(max_w, s.w)), std::max(min_h, std::min(max_h, s.h))};
+  }
+
+  bool operator==(const Constraints&) const = default;
+};
+
+struct Insets {
+  float left{}, top{}, right{}, bottom{};
+  static Insets all(float v) { return {v, v, v, v}; }
+  bool operator==(const Insets&) const = default;
+};
+
+// Leaf: sized by its measure function (or fixed size). Row/Column: children
+// one after another along x/y, extra space shared by grow factor. Stack:
+// children on top of each other.
+enum class LayoutKind : std::uint8_t { Leaf, Row, Column, Stack };
+
+// Cross-axis placement of children (both axes for Stack).
+enum class Align : std::uint8_t { Start, Center, End, Stretch };
+
+struct LayoutStats {
+  std::uint64_t measures{};      // measure requests
+  std::uint64_t measure_hits{};  // answered from a node's cache
+  std::uint64_t arranges{};      // arrange requests
+  std::uint64_t arrange_skips{}; // clean node, same frame: subtree skipped
+  std::uint64_t moved{};         // clean node, same size: subtree only translated
+  std::uint64_t layouts{};
+  std::chrono::nanoseconds last_layout{};
+
+  double hit_rate() const { return measures ? (double)measure_hits / (double)measures : 0.0; }
+};
+
+class LayoutTree;
+
+// Node of a measure/arrange layout tree. Measure results are cached per node
+// by incoming Constraints; changing a node's style or content (mark_dirty)
+// drops the caches of the node and its ancestors only, and the next layout
+// re-arranges just the dirty path plus whatever got a new frame.
+class LayoutNode {
+public:
+  using MeasureFn = std::function<Size(const Constraints&)>;
+  using FrameFn   = std::function<void(const Rect&)>;
+
+  explicit LayoutNode(LayoutKind kind = LayoutKind::Leaf) : kind_(kind) {}
+
+  LayoutNode(const LayoutNode&) = delete;
+  LayoutNode& operator=(const LayoutNode&) = delete;
+
+  // Appends a child and returns it.
+  LayoutNode& add(LayoutKind kind = LayoutKind::Leaf) {
+    return add(std::make_unique<LayoutNode>(kind));
+  }
+  LayoutNode& add(std::unique_ptr<LayoutNode> child) {
+    child->parent_ = this;
+    children_.push_back(std::move(child));
+    mark_dirty();
+    return *children_.back();
+  }
+  std::unique_ptr<LayoutNode> remove(LayoutNode& child) {
+    auto it = std::find_if(children_.begin(), children_.end(),
+                           [&](const auto& c) { return c.get() == &child; });
+    if (it == children_.end()) return nullptr;
+    std::unique_ptr<LayoutNode> out = std::move(*it);
+    children_.erase(it);
+    out->parent_ = nullptr;
+    mark_dirty();
+    return out;
+  }
+
+  // Style. A negative width/height means "from content".
+  LayoutNode& set_kind(LayoutKind k)        { return set(kind_, k); }
+  LayoutNode& set_size(float w, float h)    { set(width_, w); return set(height_, h); }
+  LayoutNode& set_min(float w, float h)     { set(min_w_, w); return set(min_h_, h); }
+  LayoutNode& set_max(float w, float h)     { set(max_w_, w); return set(max_h_, h); }
+  LayoutNode& set_grow(float g)             { return set(grow_, g); }
+  LayoutNode& set_padding(Insets p)         { return set(padding_, p); }
+  LayoutNode& set_gap(float g)              { return set(gap_, g); }
+  LayoutNode& set_align(Align a)            { return set(align_, a); }
+  LayoutNode& set_measure(MeasureFn fn)     { measure_fn_ = std::move(fn); mark_dirty(); return *this; }
+
+  // Called after a layout that gave this node a new frame (absolute coordinates).
+  LayoutNode& on_frame(FrameFn fn) { frame_fn_ = std::move(fn); return *this; }
+
+  // Content changed (e.g. a label's text): re-measure this node and its ancestors.
+  void mark_dirty() {
+    for (LayoutNode* n = this; n && !n->dirty_; n = n->parent_) {
+      n->dirty_ = true;
+      n->cached_ = 0;
+    }
+  }
+
+  bool dirty() const { return dirty_; }
+  const Rect& frame() const { return frame_; }
+  LayoutNode* parent() const { return parent_; }
+  std::size_t child_count() const { return children_.size(); }
+  LayoutNode& child(std::size_t i) const { return *children_[i]; }
+
+private:
+  friend class LayoutTree;
+
+  struct Pass {
+    LayoutStats& stats;
+    std::vector<Size>& scratch; // child sizes, used as a stack
+  };
+
+  template <class T>
+  LayoutNode& set(T& field, const T& v) {
+    if (!(field == v)) {
+      field = v;
+      mark_dirty();
+    }
+    return *this;
+  }
+
+  static bool same(const Rect& a, const Rect& b) {
+    return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+  }
+
+  bool is_row() const { return kind_ == LayoutKind::Row; }
+  static float main(const Size& s, bool row)  { return row ? s.w : s.h; }
+  static float cross(const Size& s, bool row) { return row ? s.h : s.w; }
+
+  Size measure(const Constraints& c, Pass& p) {
+    ++p.stats.measures;
+    for (std::size_t i = 0; i < cached_; ++i) {
+      if (cache_[i].first == c) {
+        ++p.stats.measure_hits;
+        return cache_[i].second;
+      }
+    }
+    const Size s = compute(c, p);
+    cache_[next_slot_] = {c, s};
+    next_slot_ = (next_slot_ + 1) % cache_.size();
+    cached_ = std::min(cached_ + 1, cache_.size());
+    return s;
+  }
+
+  Size compute(const Constraints& c, Pass& p) {
+    // The node's own limits, narrowed by the incoming ones.
+    Constraints own{std::max(c.min_w, min_w_), std::max(c.min_h, min_h_),
+                    std::min(c.max_w, max_w_), std::min(c.max_h, max_h_)};
+    if (width_ >= 0)  own.min_w = own.max_w = c.constrain(Size{width_, 0}).w;
+    if (height_ >= 0) own.min_h = own.max_h = c.constrain(Size{0, height_}).h;
+
+    const float pad_w = padding_.left + padding_.right;
+    const float pad_h = padding_.top + padding_.bottom;
+    const Constraints inner{0, 0, std::max(0.f, own.max_w - pad_w), std::max(0.f, own.max_h - pad_h)};
+
+    Size content{};
+    switch (kind_) {
+      case LayoutKind::Leaf:
+        if (measure_fn_) content = measure_fn_(inner);
+        break;
+      case LayoutKind::Stack:
+        for (auto& ch : children_) {
+          const Size s = ch->measure(inner, p);
+          content = {std::max(content.w, s.w), std::max(content.h, s.h)};
+        }
+        break;
+      case LayoutKind::Row:
+      case LayoutKind::Column: {
+        const bool row = is_row();
+        const Constraints cc = row ? Constraints{0, 0, Constraints::kUnbounded, inner.max_h}
+                                   : Constraints{0, 0, inner.max_w, Constraints::kUnbounded};
+        float m = children_.empty() ? 0.f : gap_ * (float)(children_.size() - 1);
+        float x = 0.f;
+        for (auto& ch : children_) {
+          const Size s = ch->measure(cc, p);
+          m += main(s, row);
+          x = std::max(x, cross(s, row));
+        }
+        content = row ? Size{m, x} : Size{x, m};
+        break;
+      }
+    }
+    return own.constrain(Size{content.w + pad_w, content.h + pad_h});
+  }
+
+  void arrange(const Rect& r, Pass& p) {
+    ++p.stats.arranges;
+    if (!dirty_) {
+      if (same(r, frame_)) { ++p.stats.arrange_skips; return; }
+      if (r.w == frame_.w && r.h == frame_.h) { translate(r.x - frame_.x, r.y - frame_.y, p); return; }
+    }
+    frame_ = r;
+    dirty_ = false;
+    if (frame_fn_) frame_fn_(frame_);
+    if (children_.empty()) return;
+
+    const Rect in{r.x + padding_.left, r.y + padding_.top,
+                  std::max(0.f, r.w - padding_.left - padding_.right),
+                  std::max(0.f, r.h - padding_.top - padding_.bottom)};
+
+    if (kind_ == LayoutKind::Stack || kind_ == LayoutKind::Leaf) {
+      for (auto& ch : children_) {
+        Size s = align_ == Align::Stretch ? Size{in.w, in.h} : ch->measure(Constraints::loose({in.w, in.h}), p);
+        s = ch->limits().constrain(s);
+        ch->arrange(Rect{in.x + offset(in.w, s.w), in.y + offset(in.h, s.h), s.w, s.h}, p);
+      }
+      return;
+    }
+
+    const bool row = is_row();
+    const float main_avail  = row ? in.w : in.h;
+    const float cross_avail = row ? in.h : in.w;
+    const Constraints cc = row ? Constraints{0, 0, Constraints::kUnbounded, cross_avail}
+                               : Constraints{0, 0, cross_avail, Constraints::kUnbounded};
+
+    const std::size_t base = p.scratch.size();
+    float used = gap_ * (float)(children_.size() - 1);
+    float grow_total = 0.f;
+    for (auto& ch : children_) {
+      const Size s = ch->measure(cc, p);
+      p.scratch.push_back(s);
+      used += main(s, row);
+      grow_total += ch->grow_;
+    }
+    const float free = std::max(0.f, main_avail - used);
+
+    float pos = row ? in.x : in.y;
+    for (std::size_t i = 0; i < children_.size(); ++i) {
+      LayoutNode& ch = *children_[i];
+      const Size s = p.scratch[base + i];
+      const Constraints lim = ch.limits();
+      float m = main(s, row) + (grow_total > 0 ? free * ch.grow_ / grow_total : 0.f);
+      float x = align_ == Align::Stretch ? cross_avail : std::min(cross(s, row), cross_avail);
+      const Size sz = lim.constrain(row ? Size{m, x} : Size{x, m});
+      m = main(sz, row);
+      x = cross(sz, row);
+      const float off = offset(cross_avail, x);
+      ch.arrange(row ? Rect{pos, in.y + off, m, x} : Rect{in.x + off, pos, x, m}, p);
+      pos += m + gap_;
+    }
+    p.scratch.resize(base);
+  }
+
+  // Clean subtree whose frame only moved: shift frames, no measuring.
+  void translate(float dx, float dy, Pass& p) {
+    ++p.stats.moved;
+    frame_.x += dx;
+    frame_.y += dy;
+    if (frame_fn_) frame_fn_(frame_);
+    for (auto& ch : children_) ch->translate(dx, dy, p);
+  }
+
+  float offset(float avail, float size) const {
+    switch (align_) {
+      case Align::Center: return (avail - size) * 0.5f;
+      case Align::End:    return avail - size;
+      default:            return 0.f;
+    }
+  }
+
+  Constraints limits() const {
+    Constraints c{min_w_, min_h_, max_w_, max_h_};
+    if (width_ >= 0)  c.min_w = c.max_w = width_;
+    if (height_ >= 0) c.min_h = c.max_h = height_;
+    return c;
+  }
+
+  LayoutKind kind_;
+  Align align_{Align::Stretch};
+  float width_{-1}, height_{-1};
+  float min_w_{0}, min_h_{0};
+  float max_w_{Constraints::kUnbounded}, max_h_{Constraints::kUnbounded};
+  float grow_{0};
+  float gap_{0};
+  Insets padding_{};
+  MeasureFn measure_fn_;
+  FrameFn frame_fn_;
+
+  LayoutNode* parent_{nullptr};
+  std::vector<std::unique_ptr<LayoutNode>> children_;
+
+  bool dirty_{true};
+  Rect frame_{};
+  // Enough for the constraints a node sees within a pass (measure, then
+  // arrange with stretched cross size) and across a resize back and forth.
+  std::array<std::pair<Constraints, Size>, 4> cache_{};
+  std::size_t cached_{0}, next_slot_{0};
+};
+
+// Owns the root node and runs layout passes.
+//
+//   LayoutTree tree(LayoutKind::Column);
+//   auto& bar = tree.root().add(LayoutKind::Row).set_size(-1, 32);
+//   bar.add().set_grow(1).on_frame([&](const Rect& r){ btn.set_rect(r); });
+//   win->on_paint([&](Canvas& g){ tree.layout(Rect{0, 0, w, h}); ... });
+class LayoutTree {
+public:
+  explicit LayoutTree(LayoutKind root_kind = LayoutKind::Column) : root_(root_kind) {}
+
+  LayoutNode& root() { return root_; }
+
+  // Lays the tree out into bounds; cheap when nothing changed.
+  void layout(const Rect& bounds) {
+    const auto t0 = std::chrono::steady_clock::now();
+    LayoutNode::Pass p{stats_, scratch_};
+    root_.arrange(bounds, p);
+    ++stats_.layouts;
+    stats_.last_layout = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - t0);
+  }
+
+  const LayoutStats& stats() const { return stats_; }
+  void reset_stats() { stats_ = LayoutStats{}; }
+
+private:
+  LayoutNode root_;
+  LayoutStats stats_;
+  std::vector<Size> scratch_;
+};
+
+} // namespace pulseui::ui
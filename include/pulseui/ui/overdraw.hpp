@@ -0,0 +1,275 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include <pulseui/ui/canvas.hpp>
+#include <pulseui/ui/display_list.hpp>
+#include <pulseui/ui/region.hpp>
+
+namespace pulseui::ui {
+
+struct CullStats {
+  std::uint64_t commands_in{};
+  std::uint64_t dropped{};  // fully hidden by later opaque fills or a later clear
+  std::uint64_t trimmed{};  // fills shrunk to their visible part
+  double area_in{};         // fill area before culling, in px
+  double area_out{};        // and after
+};
+
+// Occlusion culling over a frame's draw commands. Walking the frame back to
+// front, every opaque fill (alpha == 1) becomes an occluder; an earlier
+// command inside one occluder is dropped, an earlier fill that an occluder
+// covers along a whole edge is trimmed to the rest. Everything before the
+// last clear is dropped; the clear itself too once set_surface() is known
+// and an occluder covers it.
+//
+//   OcclusionCuller culler;
+//   culler.set_surface(Rect{0, 0, w, h});
+//   win->on_paint([&](Canvas& g){ culler.paint(g, [&](Canvas& c){ ...draw... }); });
+//
+// Only single occluders are tested, so a command hidden by a union of
+// several rects survives; what is dropped is always truly invisible.
+class OcclusionCuller {
+public:
+  // Area clear() paints, i.e. the window or the damaged part of it.
+  void set_surface(Rect r) { surface_ = r; }
+
+  template <class Paint>
+  void paint(Canvas& target, Paint&& paint) {
+    list_.clear();
+    RecordingCanvas rec(list_, &target);
+    paint(static_cast<Canvas&>(rec));
+    replay(list_, target);
+  }
+
+  // Replays list into target minus what is hidden.
+  const CullStats& replay(const DisplayList& list, Canvas& target) {
+    const auto cmds = list.commands();
+    stats_ = CullStats{};
+    stats_.commands_in = cmds.size();
+    out_.assign(cmds.size(), Rect{});
+    keep_.assign(cmds.size(), false);
+    occluders_.clear();
+
+    bool cleared = false;
+    for (std::size_t i = cmds.size(); i-- > 0;) {
+      const DrawCommand& cmd = cmds[i];
+      if (cleared) continue;
+
+      if (cmd.kind == DrawCommand::Clear) {
+        cleared = true; // nothing before this is visible
+        keep_[i] = empty(surface_) || !hidden(surface_);
+        continue;
+      }
+
+      if (cmd.kind == DrawCommand::DrawText) {
+        const Point p{cmd.rect.x, cmd.rect.y};
+        keep_[i] = !hidden(text_bounds(p, target.measure_text(list.text().view(cmd.text), cmd.font), cmd.font));
+        continue;
+      }
+
+      if (cmd.kind == DrawCommand::DrawImage) { // may be translucent: never an occluder
+        keep_[i] = !hidden(cmd.rect);
+        continue;
+      }
+
+      stats_.area_in += area(cmd.rect);
+      Rect r = cmd.rect;
+      if (hidden(r)) continue;
+      if (trim(r)) ++stats_.trimmed;
+      keep_[i] = !empty(r);
+      out_[i] = r;
+      stats_.area_out += area(r);
+      if (cmd.color.a >= 1.f) add_occluder(cmd.rect);
+    }
+
+    for (std::size_t i = 0; i < cmds.size(); ++i) {
+      if (!keep_[i]) { ++stats_.dropped; continue; }
+      const DrawCommand& cmd = cmds[i];
+      switch (cmd.kind) {
+        case DrawCommand::Clear:    target.clear(cmd.color); break;
+        case DrawCommand::FillRect: target.fill_rect(out_[i], cmd.color); break;
+        case DrawCommand::DrawText:
+          target.draw_text(Point{cmd.rect.x, cmd.rect.y}, list.text().view(cmd.text), cmd.font, cmd.color);
+          break;
+        case DrawCommand::DrawImage: target.draw_image(cmd.rect, list.image(cmd.image), cmd.color.a); break;
+      }
+    }
+    return stats_;
+  }
+
+  // Stats of the last frame.
+  const CullStats& stats() const { return stats_; }
+
+private:
+  // The largest occluders are kept; this bounds the cost per command.
+  static constexpr std::size_t kMaxOccluders = 32;
+
+  bool hidden(const Rect& r) const {
+    for (const Rect& o : occluders_) {
+      if (contains(o, r)) return true;
+    }
+    return false;
+  }
+
+  // Cuts off the parts of r that an occluder covers across r's full width or
+  // height. Returns true if r shrank.
+  bool trim(Rect& r) const {
+    bool changed = false;
+    for (const Rect& o : occluders_) {
+      if (!intersects(o, r)) continue;
+      const bool spans_x = o.x <= r.x && o.x + o.w >= r.x + r.w;
+      const bool spans_y = o.y <= r.y && o.y + o.h >= r.y + r.h;
+      if (spans_x) {
+        if (o.y <= r.y) {                       // covers the top
+          const float b = r.y + r.h;
+          r.y = o.y + o.h; r.h = b - r.y; changed = true;
+        } else if (o.y + o.h >= r.y + r.h) {    // covers the bottom
+          r.h = o.y - r.y; changed = true;
+        }
+      } else if (spans_y) {
+        if (o.x <= r.x) {                       // covers the left
+          const float e = r.x + r.w;
+          r.x = o.x + o.w; r.w = e - r.x; changed = true;
+        } else if (o.x + o.w >= r.x + r.w) {    // covers the right
+          r.w = o.x - r.x; changed = true;
+        }
+      }
+      if (empty(r)) return true;
+    }
+    return changed;
+  }
+
+  void add_occluder(const Rect& r) {
+    if (occluders_.size() < kMaxOccluders) {
+      occluders_.push_back(r);
+      return;
+    }
+    auto smallest = std::min_element(occluders_.begin(), occluders_.end(),
+                                     [](const Rect& a, const Rect& b) { return area(a) < area(b); });
+    if (area(*smallest) < area(r)) *smallest = r;
+  }
+
+  Rect surface_{};
+  DisplayList list_;
+  std::vector<Rect> out_;
+  std::vector<bool> keep_;
+  std::vector<Rect> occluders_;
+  CullStats stats_;
+};
+
+struct OverdrawStats {
+  std::uint64_t pixels{};    // pixels of the surface
+  std::uint64_t covered{};   // pixels written at least once
+  std::uint64_t writes{};    // pixel writes in total
+  std::uint32_t max{};       // most writes to a single pixel
+  // histogram[k]: pixels written k times; the last bucket collects the rest
+  std::array<std::uint64_t, 8> histogram{};
+
+  std::uint64_t wasted() const { return writes - covered; }
+  double mean() const { return covered ? (double)writes / (double)covered : 0.0; }
+};
+
+// Instrumentation canvas: counts how often each pixel of a width x height
+// surface is written (clear, fills, text boxes and images, clipped to damage()) and
+// forwards to an optional target.
+//
+//   OverdrawCanvas od(w, h, &g);
+//   paint(od);
+//   od.stats().mean(); save(od.heatmap());
+class OverdrawCanvas final : public Canvas {
+public:
+  OverdrawCanvas(int width, int height, Canvas* target = nullptr)
+    : width_(std::max(width, 0)), height_(std::max(height, 0)), target_(target),
+      counts_((std::size_t)width_ * (std::size_t)height_, 0) {}
+
+  void clear(Color c) override {
+    const Region* d = damage();
+    if (d) {
+      for (const Rect& r : d->rects()) count(r);
+    } else {
+      count(Rect{0, 0, (float)width_, (float)height_});
+    }
+    if (target_) target_->clear(c);
+  }
+  void fill_rect(Rect r, Color c) override {
+    clipped(r);
+    if (target_) target_->fill_rect(r, c);
+  }
+  void draw_text(Point p, std::string_view text, const Font& f, Color c) override {
+    const TextMetrics m = measure_text(text, f);
+    clipped(Rect{p.x, p.y, m.width, m.height()});
+    if (target_) target_->draw_text(p, text, f, c);
+  }
+  void draw_image(Rect dst, const Image& img, float opacity) override {
+    clipped(dst);
+    if (target_) target_->draw_image(dst, img, opacity);
+  }
+  TextMetrics measure_text(std::string_view text, const Font& f) override {
+    return target_ ? target_->measure_text(text, f) : Canvas::measure_text(text, f);
+  }
+  const Region* damage() const override { return target_ ? target_->damage() : nullptr; }
+  float dpi_scale() const override { return target_ ? target_->dpi_scale() : 1.f; }
+
+  void reset() { std::fill(counts_.begin(), counts_.end(), 0); }
+
+  int width()  const { return width_; }
+  int height() const { return height_; }
+  std::uint16_t at(int x, int y) const { return counts_[(std::size_t)y * width_ + x]; }
+
+  OverdrawStats stats() const {
+    OverdrawStats s;
+    s.pixels = counts_.size();
+    for (std::uint16_t n : counts_) {
+      s.writes += n;
+      s.covered += n != 0;
+      s.max = std::max<std::uint32_t>(s.max, n);
+      ++s.histogram[std::min<std::size_t>(n, s.histogram.size() - 1)];
+    }
+    return s;
+  }
+
+  // RGBA8 pixels, R in the low byte: untouched pixels black, then blue,
+  // green, yellow, orange and red for 1, 2, 3, 4 and 5+ writes.
+  std::vector<std::uint32_t> heatmap() const {
+    static constexpr std::uint32_t ramp[] = {
+      0xFF000000u, 0xFFC04000u, 0xFF00C000u, 0xFF00E0E0u, 0xFF0080FFu, 0xFF0000FFu,
+    };
+    constexpr std::size_t last = sizeof(ramp) / sizeof(ramp[0]) - 1;
+    std::vector<std::uint32_t> out(counts_.size());
+    for (std::size_t i = 0; i < counts_.size(); ++i) out[i] = ramp[std::min<std::size_t>(counts_[i], last)];
+    return out;
+  }
+
+private:
+  void clipped(const Rect& r) {
+    const Region* d = damage();
+    if (!d) { count(r); return; }
+    for (const Rect& dr : d->rects()) count(intersect(r, dr));
+  }
+
+  // Pixel coverage follows the raster backend: edges rounded to the nearest pixel.
+  void count(const Rect& r) {
+    if (empty(r)) return;
+    const int x0 = std::clamp((int)std::lroundf(r.x), 0, width_);
+    const int y0 = std::clamp((int)std::lroundf(r.y), 0, height_);
+    const int x1 = std::clamp((int)std::lroundf(r.x + r.w), x0, width_);
+    const int y1 = std::clamp((int)std::lroundf(r.y + r.h), y0, height_);
+    for (int y = y0; y < y1; ++y) {
+      std::uint16_t* row = counts_.data() + (std::size_t)y * width_;
+      for (int x = x0; x < x1; ++x) {
+        if (row[x] != 0xFFFF) ++row[x];
+      }
+    }
+  }
+
+  int width_, height_;
+  Canvas* target_;
+  std::vector<std::uint16_t> counts_;
+};
+
+} // namespace pulseui::ui
@@ -0,0 +1,149 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <vector>
+#include <pulseui/ui/input.hpp>
+
+namespace pulseui::ui {
+
+inline bool  empty(const Rect& r) { return r.w <= 0.f || r.h <= 0.f; }
+inline float area(const Rect& r)  { return empty(r) ? 0.f : r.w * r.h; }
+
+inline Rect intersect(const Rect& a, const Rect& b) {
+  const float x0 = std::max(a.x, b.x), y0 = std::max(a.y, b.y);
+  const float x1 = std::min(a.x + a.w, b.x + b.w), y1 = std::min(a.y + a.h, b.y + b.h);
+  if (x1 <= x0 || y1 <= y0) return Rect{};
+  return Rect{x0, y0, x1 - x0, y1 - y0};
+}
+
+inline Rect unite(const Rect& a, const Rect& b) {
+  if (empty(a)) return b;
+  if (empty(b)) return a;
+  const float x0 = std::min(a.x, b.x), y0 = std::min(a.y, b.y);
+  const float x1 = std::max(a.x + a.w, b.x + b.w), y1 = std::max(a.y + a.h, b.y + b.h);
+  return Rect{x0, y0, x1 - x0, y1 - y0};
+}
+
+inline bool intersects(const Rect& a, const Rect& b) { return !empty(intersect(a, b)); }
+
+inline bool contains(const Rect& outer, const Rect& inner) {
+  return inner.x >= outer.x && inner.y >= outer.y &&
+         inner.x + inner.w <= outer.x + outer.w &&
+         inner.y + inner.h <= outer.y + outer.h;
+}
+
+inline Rect translate(const Rect& r, float dx, float dy) { return Rect{r.x + dx, r.y + dy, r.w, r.h}; }
+
+// Parts of area that scrolling its content by (dx, dy) leaves uncovered: at
+// most one horizontal and one vertical strip.
+template <class F>
+void scroll_exposed(const Rect& area, float dx, float dy, F&& out) {
+  const float ax = std::min(std::abs(dx), area.w), ay = std::min(std::abs(dy), area.h);
+  if (ay > 0) out(Rect{area.x, dy > 0 ? area.y : area.y + area.h - ay, area.w, ay});
+  if (ax > 0) {
+    // The vertical strip without the corner already in the horizontal one.
+    const float y = dy > 0 ? area.y + ay : area.y;
+    out(Rect{dx > 0 ? area.x : area.x + area.w - ax, y, ax, area.h - ay});
+  }
+}
+
+// Set of damaged rectangles. Rects are kept pairwise disjoint, so a backend
+// can clip to each of them without touching a pixel twice. When the list gets
+// long, or when painting the bounding box is about as cheap as painting the
+// pieces, the region collapses into its bounding box.
+class Region {
+public:
+  // Per-rect overhead (clip setup, callback walk) expressed in pixels.
+  static constexpr float       kRectCostPx = 4096.f;
+  static constexpr std::size_t kMaxRects   = 16;
+
+  Region() = default;
+  explicit Region(Rect r) { add(r); }
+
+  void add(Rect r) {
+    if (ui::empty(r)) return;
+    if (rects_.empty()) { rects_.push_back(r); bounds_ = r; return; }
+
+    // Cut r into the parts not yet covered by the region.
+    pieces_.assign(1, r);
+    for (const Rect& e : rects_) {
+      for (std::size_t i = 0; i < pieces_.size();) {
+        if (!ui::intersects(pieces_[i], e)) { ++i; continue; }
+        const Rect p = pieces_[i];
+        pieces_[i] = pieces_.back();
+        pieces_.pop_back();
+        subtract(p, e, pieces_);
+      }
+      if (pieces_.empty()) return; // already covered
+    }
+
+    for (const Rect& p : pieces_) insert_disjoint(p);
+    bounds_ = unite(bounds_, r);
+    maybe_collapse();
+  }
+
+  void add(const Region& other) { for (const Rect& r : other.rects_) add(r); }
+
+  void clear() { rects_.clear(); bounds_ = Rect{}; }
+
+  bool empty() const { return rects_.empty(); }
+  Rect bounds() const { return bounds_; }
+  std::span<const Rect> rects() const { return rects_; }
+
+  float area() const {
+    float a = 0.f;
+    for (const Rect& r : rects_) a += ui::area(r);
+    return a;
+  }
+
+  bool intersects(const Rect& r) const {
+    if (!ui::intersects(bounds_, r)) return false;
+    for (const Rect& e : rects_) if (ui::intersects(e, r)) return true;
+    return false;
+  }
+
+private:
+  // Appends the (up to four) parts of a that lie outside b.
+  static void subtract(const Rect& a, const Rect& b, std::vector<Rect>& out) {
+    const float ax1 = a.x + a.w, ay1 = a.y + a.h;
+    const float bx1 = b.x + b.w, by1 = b.y + b.h;
+    const float y0 = std::max(a.y, b.y), y1 = std::min(ay1, by1);
+    if (b.y > a.y) out.push_back(Rect{a.x, a.y, a.w, b.y - a.y});
+    if (by1 < ay1) out.push_back(Rect{a.x, by1, a.w, ay1 - by1});
+    if (b.x > a.x) out.push_back(Rect{a.x, y0, b.x - a.x, y1 - y0});
+    if (bx1 < ax1) out.push_back(Rect{bx1, y0, ax1 - bx1, y1 - y0});
+  }
+
+  // Merges p into an existing rect when the two form an exact rectangle.
+  void insert_disjoint(Rect p) {
+    for (std::size_t i = 0; i < rects_.size(); ++i) {
+      const Rect& e = rects_[i];
+      const bool same_row = e.y == p.y && e.h == p.h && (e.x + e.w == p.x || p.x + p.w == e.x);
+      const bool same_col = e.x == p.x && e.w == p.w && (e.y + e.h == p.y || p.y + p.h == e.y);
+      if (same_row || same_col) {
+        p = unite(e, p);
+        rects_[i] = rects_.back();
+        rects_.pop_back();
+        insert_disjoint(p);
+        return;
+      }
+    }
+    rects_.push_back(p);
+  }
+
+  void maybe_collapse() {
+    if (rects_.size() <= 1) return;
+    const float pieces = area() + kRectCostPx * (float)rects_.size();
+    if (rects_.size() > kMaxRects || ui::area(bounds_) + kRectCostPx <= pieces) {
+      rects_.assign(1, bounds_);
+    }
+  }
+
+  std::vector<Rect> rects_;
+  Rect bounds_{};
+  std::vector<Rect> pieces_; // scratch for add()
+};
+
+} // namespace pulseui::ui
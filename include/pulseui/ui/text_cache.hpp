@@ -0,0 +1,111 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <pulseui/ui/canvas.hpp>
+
+namespace pulseui::ui {
+
+struct TextCacheStats {
+  std::uint64_t hits{};
+  std::uint64_t misses{};
+  std::uint64_t evictions{};
+  std::size_t   entries{};
+  std::size_t   bytes{};
+  std::size_t   budget{};
+};
+
+// LRU cache of prepared text runs keyed by (text, font, scale). What a run
+// holds is up to the backend (converted string, shaped line, glyph boxes,
+// extents); it must be movable and report its size via `std::size_t bytes() const`.
+// Hits do not allocate. Single-threaded: backends keep one per UI thread.
+template <class Run>
+class TextCache {
+public:
+  explicit TextCache(std::size_t budget_bytes = std::size_t(4) << 20) { stats_.budget = budget_bytes; }
+
+  TextCache(const TextCache&) = delete;
+  TextCache& operator=(const TextCache&) = delete;
+
+  // Returns the run for the key, building it with make(text) on a miss. The
+  // reference stays valid until the next get().
+  template <class Make>
+  Run& get(std::string_view text, const Font& f, float scale, Make&& make) {
+    const Key key{text, f.size, scale};
+    if (auto it = index_.find(key); it != index_.end()) {
+      ++stats_.hits;
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return it->second->run;
+    }
+
+    ++stats_.misses;
+    lru_.push_front(Entry{std::string(text), f.size, scale, std::invoke(make, text), 0});
+    Entry& e = lru_.front();
+    e.bytes = kEntryOverhead + e.text.capacity() + e.run.bytes();
+    index_.emplace(Key{e.text, e.size, e.scale}, lru_.begin());
+    stats_.bytes += e.bytes;
+    stats_.entries = lru_.size();
+    trim();
+    return e.run;
+  }
+
+  void set_budget(std::size_t bytes) { stats_.budget = bytes; trim(); }
+
+  void clear() {
+    index_.clear();
+    lru_.clear();
+    stats_.bytes = 0;
+    stats_.entries = 0;
+  }
+
+  const TextCacheStats& stats() const { return stats_; }
+
+private:
+  struct Key {
+    std::string_view text;
+    float size;
+    float scale;
+    bool operator==(const Key&) const = default;
+  };
+  struct KeyHash {
+    std::size_t operator()(const Key& k) const noexcept {
+      std::size_t h = std::hash<std::string_view>{}(k.text);
+      h ^= std::hash<float>{}(k.size)  + 0x9e3779b9 + (h << 6) + (h >> 2);
+      h ^= std::hash<float>{}(k.scale) + 0x9e3779b9 + (h << 6) + (h >> 2);
+      return h;
+    }
+  };
+  struct Entry {
+    std::string text; // Key::text points here; list nodes never move
+    float size;
+    float scale;
+    Run run;
+    std::size_t bytes;
+  };
+
+  // list node + hash node, roughly
+  static constexpr std::size_t kEntryOverhead = sizeof(Entry) + 64;
+
+  // Always keeps the newest entry, even when it alone exceeds the budget.
+  void trim() {
+    while (stats_.bytes > stats_.budget && lru_.size() > 1) {
+      Entry& e = lru_.back();
+      index_.erase(Key{e.text, e.size, e.scale});
+      stats_.bytes -= e.bytes;
+      lru_.pop_back();
+      ++stats_.evictions;
+    }
+    stats_.entries = lru_.size();
+  }
+
+  std::list<Entry> lru_;
+  std::unordered_map<Key, typename std::list<Entry>::iterator, KeyHash> index_;
+  TextCacheStats stats_;
+};
+
+} // namespace pulseui::ui
@@ -0,0 +1,443 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <pulseui/ui/canvas.hpp>
+#include <pulseui/ui/input.hpp>
+#include <pulseui/ui/region.hpp>
+#include <pulseui/ui/widget.hpp>
+
+namespace pulseui::ui {
+
+// Prefix sums over item sizes (row heights or column widths) where most
+// items have a default size. Only overridden items are stored, grouped in
+// blocks, and a Fenwick tree over the per-block deltas gives O(log n)
+// offset and position lookups: 10M rows take ~80KB plus the overrides.
+class ExtentIndex {
+public:
+  static constexpr std::size_t kBlock = 1024;
+
+  explicit ExtentIndex(std::size_t count = 0, double default_size = 20.0) { reset(count, default_size); }
+
+  // Drops all overrides.
+  void reset(std::size_t count, double default_size) {
+    count_ = count;
+    def_ = default_size > 0 ? default_size : 1.0;
+    overrides_.clear();
+    tree_.assign(blocks() + 1, 0.0);
+  }
+
+  // Keeps the overrides below the new count.
+  void resize(std::size_t count) {
+    count_ = count;
+    for (auto it = overrides_.begin(); it != overrides_.end();) {
+      auto& v = it->second;
+      const std::size_t b0 = it->first * kBlock;
+      v.erase(std::remove_if(v.begin(), v.end(), [&](const Override& o) { return b0 + o.index >= count; }), v.end());
+      it = v.empty() ? overrides_.erase(it) : std::next(it);
+    }
+    tree_.assign(blocks() + 1, 0.0);
+    for (auto& [b, v] : overrides_) {
+      for (const Override& o : v) add(b, o.delta);
+    }
+  }
+
+  void set(std::size_t i, double size) {
+    if (i >= count_) return;
+    const std::size_t b = i / kBlock;
+    const auto in = (std::uint32_t)(i % kBlock);
+    const double delta = std::max(0.0, size) - def_;
+    auto& v = overrides_[b];
+    auto it = std::lower_bound(v.begin(), v.end(), in, [](const Override& o, std::uint32_t k) { return o.index < k; });
+    double old = 0.0;
+    if (it != v.end() && it->index == in) {
+      old = it->delta;
+      if (delta == 0.0) v.erase(it);
+      else it->delta = delta;
+    } else if (delta != 0.0) {
+      v.insert(it, Override{in, delta});
+    }
+    if (v.empty()) overrides_.erase(b);
+    add(b, delta - old);
+  }
+
+  std::size_t count() const { return count_; }
+  double default_size() const { return def_; }
+
+  double size(std::size_t i) const {
+    auto it = overrides_.find(i / kBlock);
+    if (it == overrides_.end()) return def_;
+    const auto in = (std::uint32_t)(i % kBlock);
+    for (const Override& o : it->second) {
+      if (o.index == in) return def_ + o.delta;
+      if (o.index > in) break;
+    }
+    return def_;
+  }
+
+  // Start of item i; offset(count()) == total().
+  double offset(std::size_t i) const {
+    i = std::min(i, count_);
+    const std::size_t b = i / kBlock;
+    double y = (double)i * def_ + prefix(b);
+    if (auto it = overrides_.find(b); it != overrides_.end()) {
+      const auto in = (std::uint32_t)(i % kBlock);
+      for (const Override& o : it->second) {
+        if (o.index >= in) break;
+        y += o.delta;
+      }
+    }
+    return y;
+  }
+
+  double total() const { return offset(count_); }
+
+  // Item containing pos, clamped to [0, count() - 1]. Requires count() > 0.
+  std::size_t index_at(double pos) const {
+    if (pos <= 0 || count_ == 0) return 0;
+    // Fenwick descent over whole blocks.
+    const std::size_t nb = blocks();
+    std::size_t k = 0;
+    double acc = 0.0;
+    std::size_t step = 1;
+    while (step * 2 <= nb) step *= 2;
+    for (; step; step /= 2) {
+      const std::size_t next = k + step;
+      if (next > nb) continue;
+      double h = tree_[next] + (double)(step * kBlock) * def_;
+      if (next == nb) h -= (double)(nb * kBlock - count_) * def_; // partial last block
+      if (acc + h <= pos) {
+        k = next;
+        acc += h;
+      }
+    }
+    if (k >= nb) return count_ - 1;
+
+    // Within block k: uniform runs between overrides.
+    const std::size_t b0 = k * kBlock, b1 = std::min(count_, b0 + kBlock);
+    double y = pos - acc;
+    std::size_t row = b0;
+    auto uniform_until = [&](std::size_t end) -> bool {
+      const double run = (double)(end - row) * def_;
+      if (y < run) {
+        row += (std::size_t)(y / def_);
+        return true;
+      }
+      y -= run;
+      row = end;
+      return false;
+    };
+    if (auto it = overrides_.find(k); it != overrides_.end()) {
+      for (const Override& o : it->second) {
+        if (uniform_until(b0 + o.index)) return std::min(row, b1 - 1);
+        const double h = def_ + o.delta;
+        if (y < h) return row;
+        y -= h;
+        ++row;
+      }
+    }
+    uniform_until(b1);
+    return std::min(row, b1 - 1);
+  }
+
+  std::size_t overrides() const {
+    std::size_t n = 0;
+    for (auto& [b, v] : overrides_) n += v.size();
+    return n;
+  }
+
+private:
+  struct Override {
+    std::uint32_t index; // within the block
+    double delta;        // size - default
+  };
+
+  std::size_t blocks() const { return (count_ + kBlock - 1) / kBlock; }
+
+  void add(std::size_t block, double d) {
+    for (std::size_t i = block + 1; i < tree_.size(); i += i & (~i + 1)) tree_[i] += d;
+  }
+
+  // Sum of the deltas of blocks [0, block).
+  double prefix(std::size_t block) const {
+    double s = 0.0;
+    for (std::size_t i = std::min(block, tree_.size() - 1); i; i -= i & (~i + 1)) s += tree_[i];
+    return s;
+  }
+
+  std::size_t count_{0};
+  double def_{20.0};
+  std::vector<double> tree_;
+  std::unordered_map<std::size_t, std::vector<Override>> overrides_; // sorted per block
+};
+
+struct VirtualStats {
+  std::uint64_t binds{};         // cells given a new (row, col)
+  std::uint64_t created{};       // widgets made by the factory
+  std::uint64_t blits{};         // scrolls handed to the window as a blit
+  std::uint64_t full_repaints{}; // scrolls that repainted the viewport
+  std::size_t visible{};         // cells materialized now
+  std::size_t pooled{};          // idle widgets kept for reuse
+};
+
+// Virtualized 2D grid: only the cells intersecting the viewport exist as
+// widgets. Cells scrolled out go back to a pool and are rebound (bind) to the
+// rows/columns scrolled in, so memory follows the viewport, not the data.
+// Scrolling hands the pixel move to the window (set_scroller, usually
+// Window::scroll) so only the exposed strip is repainted. The headless and
+// Win32 backends blit; Cocoa repaints the whole area.
+//
+//   VirtualGrid grid(Rect{0, 0, 800, 600}, 1'000'000, 50, 24, 120);
+//   grid.set_factory([]{ return std::make_unique<Button>(Rect{}, ""); });
+//   grid.set_bind([&](Widget& w, std::size_t r, std::size_t c){
+//     static_cast<Button&>(w).set_text(model.cell(r, c)); });
+//   grid.set_scroller([&](Rect a, float dx, float dy){ win->scroll(a, dx, dy); });
+//   grid.set_invalidate([&](Rect r){ win->invalidate(r); });
+//
+// Cells are not clipped to the viewport: paint whatever borders the grid
+// after it.
+class VirtualGrid : public Widget {
+public:
+  using Factory = std::function<std::unique_ptr<Widget>()>;
+  using Bind    = std::function<void(Widget&, std::size_t row, std::size_t col)>;
+  using Scroller   = std::function<void(Rect area, float dx, float dy)>;
+  using Invalidate = std::function<void(Rect)>;
+
+  VirtualGrid(Rect viewport, std::size_t rows, std::size_t cols, double row_height, double col_width)
+    : viewport_(viewport), rows_(rows, row_height), cols_(cols, col_width) {}
+
+  void set_factory(Factory f) { factory_ = std::move(f); update(true); }
+  void set_bind(Bind b) { bind_ = std::move(b); update(true); }
+  void set_scroller(Scroller s) { scroller_ = std::move(s); }
+  void set_invalidate(Invalidate i) { invalidate_ = std::move(i); }
+  // Pixels per InputEvent::scrollY unit.
+  void set_scroll_step(float px) { step_ = px; }
+
+  // Data changed: rebinds the visible cells.
+  void refresh() { update(true); repaint(viewport_); }
+
+  void set_row_count(std::size_t n) { rows_.resize(n); clamp_and_update(); }
+  void set_col_count(std::size_t n) { cols_.resize(n); clamp_and_update(); }
+  void set_row_height(std::size_t row, double h) { rows_.set(row, h); clamp_and_update(); }
+  void set_col_width(std::size_t col, double w) { cols_.set(col, w); clamp_and_update(); }
+
+  const ExtentIndex& rows() const { return rows_; }
+  const ExtentIndex& cols() const { return cols_; }
+
+  // Scroll position in content pixels, kept whole so blits stay exact.
+  double scroll_x() const { return sx_; }
+  double scroll_y() const { return sy_; }
+
+  // Returns true if the caller has to repaint the viewport: it moved and
+  // neither the scroller nor the invalidate callback took care of it.
+  bool scroll_to(double x, double y) {
+    x = std::round(std::clamp(x, 0.0, std::max(0.0, cols_.total() - viewport_.w)));
+    y = std::round(std::clamp(y, 0.0, std::max(0.0, rows_.total() - viewport_.h)));
+    const double dx = x - sx_, dy = y - sy_;
+    if (dx == 0 && dy == 0) return false;
+    sx_ = x;
+    sy_ = y;
+    bool needs_repaint = false;
+    if (scroller_ && std::abs(dx) < viewport_.w && std::abs(dy) < viewport_.h) {
+      ++stats_.blits;
+      scroller_(viewport_, (float)-dx, (float)-dy);
+    } else {
+      ++stats_.full_repaints;
+      needs_repaint = repaint(viewport_);
+    }
+    update(false);
+    return needs_repaint;
+  }
+  bool scroll_by(double dx, double dy) { return scroll_to(sx_ + dx, sy_ + dy); }
+
+  // Scrolls so that row is visible; returns like scroll_to().
+  bool reveal_row(std::size_t row) {
+    const double top = rows_.offset(row), bottom = top + rows_.size(row);
+    if (top < sy_) return scroll_to(sx_, top);
+    if (bottom > sy_ + viewport_.h) return scroll_to(sx_, bottom - viewport_.h);
+    return false;
+  }
+
+  // Widget at a viewport point, or nullptr.
+  Widget* cell_at(Point p) const {
+    if (!inside(p) || rows_.count() == 0 || cols_.count() == 0) return nullptr;
+    const std::size_t r = rows_.index_at(sy_ + (p.y - viewport_.y));
+    const std::size_t c = cols_.index_at(sx_ + (p.x - viewport_.x));
+    if (r < r0_ || r >= r0_ + nr_ || c < c0_ || c >= c0_ + nc_) return nullptr;
+    return cells_[(r - r0_) * nc_ + (c - c0_)].get();
+  }
+
+  const VirtualStats& stats() const { return stats_; }
+
+  // === Widget ===
+  Rect bounds() const override { return viewport_; }
+  void set_bounds(Rect r) override {
+    const Rect old = viewport_;
+    viewport_ = r;
+    clamp_and_update();
+    bounds_changed(old);
+  }
+
+  void paint(Canvas& g) override {
+    if (!g.needs_paint(viewport_)) return;
+    for (auto& cell : cells_) if (cell) cell->paint(g);
+  }
+
+  // True when no callback repainted the grid, so the container invalidates it.
+  bool handle_scroll(Point, float dy) override { return scroll_by(0, -(double)dy * step_); }
+
+  bool handle_mouse_move(Point p) override {
+    Widget* target = pressed_ ? pressed_ : cell_at(p);
+    bool changed = false;
+    if (target != hovered_) {
+      if (hovered_ && hovered_->handle_mouse_leave()) changed |= repaint(hovered_->bounds());
+      hovered_ = target;
+    }
+    if (target && target->handle_mouse_move(p)) changed |= repaint(target->bounds());
+    return changed;
+  }
+
+  bool handle_mouse_down(Point p, MouseButton b) override {
+    pressed_ = cell_at(p);
+    return pressed_ && pressed_->handle_mouse_down(p, b) && repaint(pressed_->bounds());
+  }
+
+  bool handle_mouse_up(Point p, MouseButton b) override {
+    Widget* target = pressed_ ? pressed_ : cell_at(p);
+    pressed_ = nullptr;
+    return target && target->handle_mouse_up(p, b) && repaint(target->bounds());
+  }
+
+  bool handle_mouse_leave() override {
+    Widget* h = std::exchange(hovered_, nullptr);
+    return h && h->handle_mouse_leave() && repaint(h->bounds());
+  }
+
+private:
+  bool inside(Point p) const {
+    return p.x >= viewport_.x && p.x < viewport_.x + viewport_.w &&
+           p.y >= viewport_.y && p.y < viewport_.y + viewport_.h;
+  }
+
+  // Reports r through the invalidate callback; without one the caller's
+  // return value asks the container to repaint the whole grid.
+  bool repaint(const Rect& r) {
+    if (!invalidate_) return true;
+    if (!empty(r)) invalidate_(intersect(r, viewport_));
+    return false;
+  }
+
+  void clamp_and_update() {
+    const double x = sx_, y = sy_;
+    sx_ = std::round(std::clamp(x, 0.0, std::max(0.0, cols_.total() - viewport_.w)));
+    sy_ = std::round(std::clamp(y, 0.0, std::max(0.0, rows_.total() - viewport_.h)));
+    update(true);
+    repaint(viewport_);
+  }
+
+  // Materializes the cells of the visible range, reusing the ones that stay
+  // visible, and positions them. rebind: rebind all of them (data changed).
+  void update(bool rebind) {
+    std::size_t r0 = 0, nr = 0, c0 = 0, nc = 0;
+    if (rows_.count() && cols_.count() && viewport_.w > 0 && viewport_.h > 0 && factory_) {
+      r0 = rows_.index_at(sy_);
+      nr = rows_.index_at(sy_ + viewport_.h - 0.5) - r0 + 1;
+      c0 = cols_.index_at(sx_);
+      nc = cols_.index_at(sx_ + viewport_.w - 0.5) - c0 + 1;
+    }
+
+    next_.resize(nr * nc);
+    for (std::size_t i = 0; i < nr; ++i) {
+      for (std::size_t j = 0; j < nc; ++j) {
+        const std::size_t r = r0 + i, c = c0 + j;
+        std::unique_ptr<Widget>& slot = next_[i * nc + j];
+        bool fresh = rebind;
+        if (r >= r0_ && r < r0_ + nr_ && c >= c0_ && c < c0_ + nc_) {
+          slot = std::move(cells_[(r - r0_) * nc_ + (c - c0_)]);
+        }
+        if (!slot) {
+          slot = take();
+          fresh = true;
+        }
+        if (fresh && bind_) {
+          bind_(*slot, r, c);
+          ++stats_.binds;
+        }
+        slot->set_bounds(cell_rect(r, c));
+      }
+    }
+    for (auto& left : cells_) if (left) release(std::move(left));
+
+    cells_.swap(next_);
+    next_.clear();
+    r0_ = r0; nr_ = nr; c0_ = c0; nc_ = nc;
+    stats_.visible = cells_.size();
+    stats_.pooled = pool_.size();
+  }
+
+  Rect cell_rect(std::size_t r, std::size_t c) const {
+    return Rect{viewport_.x + (float)(cols_.offset(c) - sx_), viewport_.y + (float)(rows_.offset(r) - sy_),
+                (float)cols_.size(c), (float)rows_.size(r)};
+  }
+
+  std::unique_ptr<Widget> take() {
+    if (!pool_.empty()) {
+      std::unique_ptr<Widget> w = std::move(pool_.back());
+      pool_.pop_back();
+      return w;
+    }
+    ++stats_.created;
+    return factory_();
+  }
+
+  void release(std::unique_ptr<Widget> w) {
+    if (hovered_ == w.get()) { w->handle_mouse_leave(); hovered_ = nullptr; }
+    if (pressed_ == w.get()) pressed_ = nullptr;
+    pool_.push_back(std::move(w));
+  }
+
+  Rect viewport_;
+  ExtentIndex rows_, cols_;
+  double sx_{0}, sy_{0};
+  float step_{40.f};
+
+  Factory factory_;
+  Bind bind_;
+  Scroller scroller_;
+  Invalidate invalidate_;
+
+  // Visible range and its cells, row-major.
+  std::size_t r0_{0}, nr_{0}, c0_{0}, nc_{0};
+  std::vector<std::unique_ptr<Widget>> cells_, next_;
+  std::vector<std::unique_ptr<Widget>> pool_;
+
+  Widget* hovered_{nullptr};
+  Widget* pressed_{nullptr};
+  VirtualStats stats_;
+};
+
+// Single-column VirtualGrid whose rows span the viewport width.
+class VirtualList : public VirtualGrid {
+public:
+  using RowBind = std::function<void(Widget&, std::size_t row)>;
+
+  VirtualList(Rect viewport, std::size_t rows, double row_height)
+    : VirtualGrid(viewport, rows, 1, row_height, viewport.w) {}
+
+  void set_bind(RowBind b) {
+    VirtualGrid::set_bind([b = std::move(b)](Widget& w, std::size_t row, std::size_t) { b(w, row); });
+  }
+
+  void set_bounds(Rect r) override {
+    set_col_width(0, r.w);
+    VirtualGrid::set_bounds(r);
+  }
+};
+
+} // namespace pulseui::ui
@@ -1,12 +1,56 @@
 #pragma once
+#include <cstdint>
 #include <pulseui/core/subscriptions.hpp>
+#include <pulseui/ui/canvas.hpp>
+#include <pulseui/ui/input.hpp>
 
 namespace pulseui::ui {
+  struct Widget;
+
+  // Something that indexes widgets by their bounds (see WidgetContainer).
+  struct WidgetHost {
+    virtual ~WidgetHost() = default;
+    virtual void child_bounds_changed(Widget& w, Rect old) = 0;
+    virtual void detach(Widget& w) = 0;
+    // The widget's look changed outside of input handling (e.g. an animation).
+    virtual void child_needs_paint(Widget&) {}
+  };
+
   struct Widget {
-    virtual ~Widget() = default;
+    Widget() = default;
+    // A copy is a new widget: not in any container, no subscriptions.
+    Widget(const Widget&) {}
+    Widget& operator=(const Widget&) { return *this; }
+    virtual ~Widget() { if (host_) host_->detach(*this); }
     virtual void mount() {}
     virtual void unmount() {}
+
+    // Geometry, painting and pointer input as used by WidgetContainer. The
+    // mouse handlers return true when the widget's look changed, i.e.
+    // bounds() needs repainting.
+    virtual Rect bounds() const { return {}; }
+    virtual void set_bounds(Rect) {}
+    virtual void paint(Canvas&) {}
+    virtual bool handle_mouse_move(Point) { return false; }
+    virtual bool handle_mouse_down(Point, MouseButton) { return false; }
+    virtual bool handle_mouse_up(Point, MouseButton) { return false; }
+    virtual bool handle_mouse_leave() { return false; }
+    // dy as in InputEvent::scrollY.
+    virtual bool handle_scroll(Point, float /*dy*/) { return false; }
+
+    WidgetHost* host() const { return host_; }
+
   protected:
+    // Call after bounds() changed so that the host can reindex the widget.
+    void bounds_changed(Rect old) { if (host_) host_->child_bounds_changed(*this, old); }
+    // Call when bounds() needs repainting for a reason the host did not see.
+    void request_paint() { if (host_) host_->child_needs_paint(*this); }
+
     pulseui::core::subs_bag subs_;
+
+  private:
+    friend class WidgetContainer;
+    WidgetHost* host_{nullptr};
+    std::uint32_t slot_{0}; // host's bookkeeping
   };
 }
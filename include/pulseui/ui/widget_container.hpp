@@ -0,0 +1,322 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <pulseui/ui/canvas.hpp>
+#include <pulseui/ui/input.hpp>
+#include <pulseui/ui/region.hpp>
+#include <pulseui/ui/widget.hpp>
+
+namespace pulseui::ui {
+
+struct ContainerStats {
+  std::uint64_t hit_tests{};
+  std::uint64_t candidates{}; // widgets looked at by hit tests and queries
+  std::uint64_t reindexed{};  // bounds changes applied to the index
+};
+
+// Non-owning set of widgets indexed by a uniform grid, so hit testing and
+// "what is under this dirty rect" look at a handful of widgets instead of all
+// of them. Later added widgets are on top. Mouse input goes to the topmost
+// widget under the pointer; hover (mouse_leave) and capture (a pressed widget
+// gets the moves and the release) are tracked here.
+//
+//   WidgetContainer root;
+//   root.add(btn);
+//   root.on_invalidate([&](Rect r){ repaint(r); });
+//   win->on_input_batch([&](auto batch){ for (auto& e : batch) root.dispatch(e); });
+//   win->on_paint([&](Canvas& g){ g.clear(bg); root.paint(g); });
+class WidgetContainer final : public WidgetHost {
+public:
+  explicit WidgetContainer(float cell_size = 64.f) : cell_(cell_size > 0 ? cell_size : 64.f) {}
+
+  ~WidgetContainer() override {
+    for (Entry& e : entries_) if (e.w) e.w->host_ = nullptr;
+  }
+
+  WidgetContainer(const WidgetContainer&) = delete;
+  WidgetContainer& operator=(const WidgetContainer&) = delete;
+
+  // w must outlive the container or be removed (destroying it removes it).
+  void add(Widget& w) {
+    if (w.host_) w.host_->detach(w);
+    std::uint32_t slot;
+    if (!free_.empty()) {
+      slot = free_.back();
+      free_.pop_back();
+    } else {
+      slot = (std::uint32_t)entries_.size();
+      entries_.emplace_back();
+    }
+    Entry& e = entries_[slot];
+    e.w = &w;
+    e.rect = w.bounds();
+    e.z = next_z_++;
+    w.host_ = this;
+    w.slot_ = slot;
+    insert(slot);
+    order_.push_back(slot);
+    invalidate(e.rect);
+  }
+
+  void remove(Widget& w) {
+    if (w.host_ != this) return;
+    const std::uint32_t slot = w.slot_;
+    Entry& e = entries_[slot];
+    erase(slot, e.rect);
+    order_.erase(std::find(order_.begin(), order_.end(), slot));
+    if (hovered_ == &w) hovered_ = nullptr;
+    if (captured_ == &w) captured_ = nullptr;
+    if (active_ == &w) active_ = nullptr;
+    ++removals_;
+    invalidate(e.rect);
+    e = Entry{};
+    free_.push_back(slot);
+    w.host_ = nullptr;
+  }
+
+  // Moves w above all other widgets.
+  void raise(Widget& w) {
+    if (w.host_ != this) return;
+    entries_[w.slot_].z = next_z_++;
+    order_.erase(std::find(order_.begin(), order_.end(), w.slot_));
+    order_.push_back(w.slot_);
+    invalidate(entries_[w.slot_].rect);
+  }
+
+  std::size_t size() const { return order_.size(); }
+
+  // Called with the bounds of every widget that needs repainting.
+  void on_invalidate(std::function<void(Rect)> fn) { invalidate_ = std::move(fn); }
+
+  // Topmost widget containing p, or nullptr.
+  Widget* hit_test(Point p) {
+    ++stats_.hit_tests;
+    const Entry* best = nullptr;
+    auto consider = [&](std::uint32_t slot) {
+      const Entry& e = entries_[slot];
+      ++stats_.candidates;
+      if (p.x >= e.rect.x && p.x < e.rect.x + e.rect.w && p.y >= e.rect.y && p.y < e.rect.y + e.rect.h &&
+          (!best || e.z > best->z)) {
+        best = &e;
+      }
+    };
+    if (auto it = cells_.find(key(cell_of(p.x), cell_of(p.y))); it != cells_.end()) {
+      for (std::uint32_t slot : it->second) consider(slot);
+    }
+    for (std::uint32_t slot : large_) consider(slot);
+    return best ? best->w : nullptr;
+  }
+
+  // Widgets intersecting r, bottom to top.
+  void query(Rect r, std::vector<Widget*>& out) {
+    out.clear();
+    collect(r);
+    for (std::uint32_t slot : hits_) out.push_back(entries_[slot].w);
+  }
+
+  // Paints the widgets under g.damage() (all of them without damage), bottom to top.
+  void paint(Canvas& g) {
+    const Region* d = g.damage();
+    if (!d) {
+      for (std::uint32_t slot : order_) entries_[slot].w->paint(g);
+      return;
+    }
+    collect(d->bounds());
+    for (std::uint32_t slot : hits_) {
+      if (d->intersects(entries_[slot].rect)) entries_[slot].w->paint(g);
+    }
+  }
+
+  // Routes a pointer event; returns true if some widget's look changed (its
+  // bounds have been passed to on_invalidate).
+  bool dispatch(const InputEvent& e) {
+    switch (e.type) {
+      case InputEvent::MouseMove: {
+        if (captured_) return deliver(*captured_, [&](Widget& w) { return w.handle_mouse_move(e.pos); });
+        return hover(hit_test(e.pos), e.pos);
+      }
+      case InputEvent::MouseDown: {
+        bool changed = hover(hit_test(e.pos), e.pos);
+        // hover() ran handlers that may have removed or destroyed the target;
+        // hovered_ is the target only while it is still here.
+        Widget* target = hovered_;
+        captured_ = target;
+        if (target) changed |= deliver(*target, [&](Widget& w) { return w.handle_mouse_down(e.pos, MouseButton::Left); });
+        return changed;
+      }
+      case InputEvent::MouseUp: {
+        Widget* target = captured_ ? captured_ : hit_test(e.pos);
+        captured_ = nullptr;
+        bool changed = false;
+        // The handler may remove or move widgets, so hit test afterwards.
+        if (target) changed = deliver(*target, [&](Widget& w) { return w.handle_mouse_up(e.pos, MouseButton::Left); });
+        return hover(hit_test(e.pos), e.pos) || changed;
+      }
+      case InputEvent::Scroll: {
+        Widget* target = captured_ ? captured_ : hit_test(e.pos);
+        if (!target) return false;
+        return deliver(*target, [&](Widget& w) { return w.handle_scroll(e.pos, e.scrollY); });
+      }
+      default:
+        return false;
+    }
+  }
+
+  Widget* hovered()  const { return hovered_; }
+  Widget* captured() const { return captured_; }
+  const ContainerStats& stats() const { return stats_; }
+
+  // === WidgetHost ===
+  void child_bounds_changed(Widget& w, Rect old) override {
+    if (w.host_ != this) return;
+    Entry& e = entries_[w.slot_];
+    erase(w.slot_, old);
+    e.rect = w.bounds();
+    insert(w.slot_);
+    ++stats_.reindexed;
+    invalidate(old);
+    invalidate(e.rect);
+  }
+
+  void detach(Widget& w) override { remove(w); }
+
+  void child_needs_paint(Widget& w) override {
+    if (w.host_ == this) invalidate(entries_[w.slot_].rect);
+  }
+
+private:
+  struct Entry {
+    Widget* w{nullptr};
+    Rect rect{};
+    std::uint64_t z{0};
+    std::uint64_t seen{0}; // query stamp, dedups widgets spanning several cells
+  };
+
+  // Widgets covering more cells than this are kept in a plain list instead.
+  static constexpr int kMaxCellsPerWidget = 64;
+
+  int cell_of(float v) const { return (int)std::floor(v / cell_); }
+
+  static std::uint64_t key(int cx, int cy) {
+    return ((std::uint64_t)(std::uint32_t)cx << 32) | (std::uint32_t)cy;
+  }
+
+  struct CellRange { int x0, y0, x1, y1; };
+
+  CellRange cells_for(const Rect& r) const {
+    return CellRange{cell_of(r.x), cell_of(r.y), cell_of(r.x + r.w), cell_of(r.y + r.h)};
+  }
+
+  static bool is_large(const CellRange& c) {
+    return (std::int64_t)(c.x1 - c.x0 + 1) * (c.y1 - c.y0 + 1) > kMaxCellsPerWidget;
+  }
+
+  void insert(std::uint32_t slot) {
+    const Rect& r = entries_[slot].rect;
+    if (empty(r)) return;
+    const CellRange c = cells_for(r);
+    if (is_large(c)) { large_.push_back(slot); return; }
+    for (int cy = c.y0; cy <= c.y1; ++cy)
+      for (int cx = c.x0; cx <= c.x1; ++cx) cells_[key(cx, cy)].push_back(slot);
+  }
+
+  void erase(std::uint32_t slot, const Rect& r) {
+    if (empty(r)) return;
+    auto drop = [slot](std::vector<std::uint32_t>& v) {
+      auto it = std::find(v.begin(), v.end(), slot);
+      if (it != v.end()) { *it = v.back(); v.pop_back(); }
+    };
+    const CellRange c = cells_for(r);
+    if (is_large(c)) { drop(large_); return; }
+    for (int cy = c.y0; cy <= c.y1; ++cy)
+      for (int cx = c.x0; cx <= c.x1; ++cx) {
+        auto it = cells_.find(key(cx, cy));
+        if (it == cells_.end()) continue;
+        drop(it->second);
+        if (it->second.empty()) cells_.erase(it);
+      }
+  }
+
+  // Fills hits_ with the slots intersecting r, bottom to top.
+  void collect(const Rect& r) {
+    hits_.clear();
+    if (empty(r)) return;
+    const std::uint64_t stamp = ++stamp_;
+    auto consider = [&](std::uint32_t slot) {
+      Entry& e = entries_[slot];
+      ++stats_.candidates;
+      if (e.seen == stamp) return;
+      e.seen = stamp;
+      if (intersects(e.rect, r)) hits_.push_back(slot);
+    };
+    const CellRange c = cells_for(r);
+    if (is_large(c) && (std::size_t)((std::int64_t)(c.x1 - c.x0 + 1) * (c.y1 - c.y0 + 1)) > cells_.size()) {
+      // Cheaper to walk the occupied cells than the whole rect.
+      for (auto& [k, slots] : cells_) for (std::uint32_t slot : slots) consider(slot);
+    } else {
+      for (int cy = c.y0; cy <= c.y1; ++cy)
+        for (int cx = c.x0; cx <= c.x1; ++cx) {
+          auto it = cells_.find(key(cx, cy));
+          if (it != cells_.end()) for (std::uint32_t slot : it->second) consider(slot);
+        }
+    }
+    for (std::uint32_t slot : large_) consider(slot);
+    std::sort(hits_.begin(), hits_.end(),
+              [this](std::uint32_t a, std::uint32_t b) { return entries_[a].z < entries_[b].z; });
+  }
+
+  bool hover(Widget* target, Point p) {
+    bool changed = false;
+    if (target != hovered_) {
+      if (hovered_) {
+        const std::uint64_t removals = removals_;
+        changed |= deliver(*hovered_, [](Widget& w) { return w.handle_mouse_leave(); });
+        // The leave handler may have removed target: look again.
+        if (removals_ != removals) target = hit_test(p);
+      }
+      hovered_ = target;
+    }
+    if (target) changed |= deliver(*target, [&](Widget& w) { return w.handle_mouse_move(p); });
+    return changed;
+  }
+
+  // Handlers may remove or destroy their own widget (remove() clears active_),
+  // which then has been invalidated already.
+  template <class Call>
+  bool deliver(Widget& w, Call&& call) {
+    active_ = &w;
+    const bool changed = call(w);
+    Widget* alive = active_;
+    active_ = nullptr;
+    if (changed && alive) invalidate(entries_[alive->slot_].rect);
+    return changed;
+  }
+
+  void invalidate(const Rect& r) {
+    if (invalidate_ && !empty(r)) invalidate_(r);
+  }
+
+  float cell_;
+  std::vector<Entry> entries_;
+  std::vector<std::uint32_t> free_;
+  std::vector<std::uint32_t> order_; // bottom to top
+  std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> cells_;
+  std::vector<std::uint32_t> large_;
+  std::vector<std::uint32_t> hits_;
+  std::uint64_t next_z_{0};
+  std::uint64_t stamp_{0};
+  std::uint64_t removals_{0}; // remove() calls, to notice handlers removing widgets
+
+  Widget* hovered_{nullptr};
+  Widget* captured_{nullptr};
+  Widget* active_{nullptr}; // widget whose handler is running
+  std::function<void(Rect)> invalidate_;
+  ContainerStats stats_;
+};
+
+} // namespace pulseui::ui
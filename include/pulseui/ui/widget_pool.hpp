@@ -0,0 +1,308 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <pulseui/ui/button.hpp>
+#include <pulseui/ui/canvas.hpp>
+#include <pulseui/ui/display_list.hpp>
+#include <pulseui/ui/input.hpp>
+#include <pulseui/ui/region.hpp>
+
+namespace pulseui::ui {
+
+// Structure-of-arrays set of buttons for dense grids: rects, state bits,
+// style indices, interned labels and handler ids each live in one contiguous
+// array, styles and click handlers are shared tables. A uniform grid indexes
+// the rects (as in WidgetContainer), so hit testing looks at the few buttons
+// near the pointer. Looks like Button.
+//
+//   ButtonPool pool;
+//   auto on_cell = pool.add_handler([&](ButtonPool::id b){ select(b); });
+//   for (...) pool.add(cell_rect, label, 0, on_cell);
+//   pool.on_invalidate(repaint);
+//   win->on_input_batch([&](auto batch){ pool.dispatch(batch); });
+//   win->on_paint([&](Canvas& g){ g.clear(bg); pool.paint_all(g); });
+//
+// paint_all draws all backgrounds, then all labels, so buttons must not
+// overlap (they never do in a grid).
+class ButtonPool {
+public:
+  using id = std::uint32_t;
+  using style_id = std::uint16_t;
+  using handler_id = std::uint32_t;
+  using Handler = std::function<void(id)>;
+
+  static constexpr id kNone = std::numeric_limits<id>::max();
+  static constexpr handler_id kNoHandler = std::numeric_limits<handler_id>::max();
+
+  ButtonPool() { styles_.push_back(ButtonStyle{}); }
+
+  // Style 0 is the default ButtonStyle.
+  style_id add_style(ButtonStyle s) {
+    styles_.push_back(std::move(s));
+    return (style_id)(styles_.size() - 1);
+  }
+  const ButtonStyle& style(style_id s) const { return styles_[s]; }
+
+  handler_id add_handler(Handler h) {
+    handlers_.push_back(std::move(h));
+    return (handler_id)(handlers_.size() - 1);
+  }
+
+  id add(Rect r, std::string_view text, style_id s = 0, handler_id h = kNoHandler) {
+    rects_.push_back(r);
+    state_.push_back(0);
+    style_.push_back(s);
+    text_.push_back(labels_.intern(text));
+    handler_.push_back(h);
+    compact_labels_if_needed();
+    const id b = (id)(rects_.size() - 1);
+    index_insert(b);
+    return b;
+  }
+
+  void set_rect(id b, Rect r) {
+    invalidate(rects_[b]);
+    index_erase(b);
+    rects_[b] = r;
+    index_insert(b);
+    invalidate(r);
+  }
+  // Interned: buttons with the same label share it. Labels no button uses
+  // any more are dropped when the pool has doubled since the last compaction.
+  void set_text(id b, std::string_view text) {
+    text_[b] = labels_.intern(text);
+    compact_labels_if_needed();
+    invalidate(rects_[b]);
+  }
+  void set_style(id b, style_id s)           { style_[b] = s; invalidate(rects_[b]); }
+  void set_handler(id b, handler_id h)       { handler_[b] = h; }
+  void set_visible(id b, bool v) {
+    const std::uint8_t st = v ? (std::uint8_t)(state_[b] & ~kHidden) : (std::uint8_t)(state_[b] | kHidden);
+    if (st == state_[b]) return;
+    state_[b] = st;
+    if (!v && hovered_ == b) hovered_ = kNone;
+    if (!v && pressed_ == b) pressed_ = kNone;
+    invalidate(rects_[b]);
+  }
+
+  std::size_t size() const { return rects_.size(); }
+  const Rect& rect(id b) const { return rects_[b]; }
+  std::string_view text(id b) const { return labels_.view(text_[b]); }
+  bool hovered(id b) const { return (state_[b] & kHovered) != 0; }
+  bool pressed(id b) const { return (state_[b] & kPressed) != 0; }
+
+  void clear() {
+    rects_.clear(); state_.clear(); style_.clear(); text_.clear(); handler_.clear();
+    labels_.clear();
+    cells_.clear();
+    large_.clear();
+    compact_at_ = kMinCompactBytes;
+    hovered_ = pressed_ = kNone;
+  }
+
+  // Called with the rect of every button whose look changed.
+  void on_invalidate(std::function<void(Rect)> fn) { invalidate_ = std::move(fn); }
+
+  // Topmost (last added) visible button containing p, or kNone.
+  id hit_test(Point p) const {
+    id best = kNone;
+    auto consider = [&](id i) {
+      const Rect& r = rects_[i];
+      if ((best == kNone || i > best) && p.x >= r.x && p.x < r.x + r.w && p.y >= r.y && p.y < r.y + r.h &&
+          !(state_[i] & kHidden)) {
+        best = i;
+      }
+    };
+    if (auto it = cells_.find(key(cell_of(p.x), cell_of(p.y))); it != cells_.end()) {
+      for (id i : it->second) consider(i);
+    }
+    for (id i : large_) consider(i);
+    return best;
+  }
+
+  // out[i] = hit_test(points[i]).
+  void hit_test(std::span<const Point> points, std::span<id> out) const {
+    for (std::size_t k = 0; k < points.size(); ++k) out[k] = hit_test(points[k]);
+  }
+
+  // Routes pointer events (hover, press, click) like Button does for one.
+  void dispatch(std::span<const InputEvent> events) {
+    for (const InputEvent& e : events) dispatch(e);
+  }
+
+  bool dispatch(const InputEvent& e) {
+    switch (e.type) {
+      case InputEvent::MouseMove: return hover(pressed_ != kNone ? pressed_ : hit_test(e.pos), e.pos);
+      case InputEvent::MouseDown: {
+        const id b = hit_test(e.pos);
+        bool changed = hover(b, e.pos);
+        if (b != kNone) {
+          pressed_ = b;
+          changed |= set_state(b, (std::uint8_t)(state_[b] | kPressed));
+        }
+        return changed;
+      }
+      case InputEvent::MouseUp: {
+        if (pressed_ == kNone) return false;
+        const id b = pressed_;
+        pressed_ = kNone;
+        set_state(b, (std::uint8_t)(state_[b] & ~kPressed));
+        // handlers_ is a deque, so a handler calling add_handler() does not move itself.
+        if (hit_test(e.pos) == b && handler_[b] != kNoHandler && handlers_[handler_[b]]) handlers_[handler_[b]](b);
+        hover(hit_test(e.pos), e.pos);
+        return true;
+      }
+      default:
+        return false;
+    }
+  }
+
+  // Paints the visible buttons that intersect g.damage(): backgrounds first,
+  // then labels, so the backend switches between fills and text only once.
+  void paint_all(Canvas& g) {
+    const Region* d = g.damage();
+    const Rect db = d ? d->bounds() : Rect{};
+    todo_.clear();
+    for (std::size_t i = 0; i < rects_.size(); ++i) {
+      if (state_[i] & kHidden) continue;
+      if (d && (!intersects(db, rects_[i]) || !d->intersects(rects_[i]))) continue;
+      todo_.push_back((id)i);
+    }
+
+    for (id b : todo_) {
+      const Rect& r = rects_[b];
+      const ButtonStyle& s = styles_[style_[b]];
+      const bool down = state_[b] & kPressed;
+      const Color bg = down ? s.bg_down : ((state_[b] & kHovered) ? s.bg_hover : s.bg_normal);
+      g.fill_rect(r, bg);
+      if (down) {
+        g.fill_rect(Rect{r.x, r.y, r.w, 1},           mul(bg, 0.8f));
+        g.fill_rect(Rect{r.x, r.y + r.h - 1, r.w, 1}, mul(bg, 1.2f));
+      }
+    }
+
+    // Line height per style, measured once per paint (text metrics are cached
+    // by the backend, but this skips the lookups).
+    line_height_.assign(styles_.size(), -1.f);
+    for (id b : todo_) {
+      const ButtonStyle& s = styles_[style_[b]];
+      float& lh = line_height_[style_[b]];
+      if (lh < 0) lh = g.measure_text("Ag", s.font).height();
+      const Rect& r = rects_[b];
+      g.draw_text(Point{r.x + s.padding_px, r.y + (r.h - lh) * 0.5f}, labels_.view(text_[b]), s.font, s.fg);
+    }
+  }
+
+private:
+  enum : std::uint8_t { kHovered = 1, kPressed = 2, kHidden = 4 };
+
+  bool set_state(id b, std::uint8_t st) {
+    if (state_[b] == st) return false;
+    state_[b] = st;
+    invalidate(rects_[b]);
+    return true;
+  }
+
+  bool hover(id b, Point) {
+    if (b == hovered_) return false;
+    bool changed = false;
+    if (hovered_ != kNone) changed |= set_state(hovered_, (std::uint8_t)(state_[hovered_] & ~kHovered));
+    hovered_ = b;
+    if (b != kNone) changed |= set_state(b, (std::uint8_t)(state_[b] | kHovered));
+    return changed;
+  }
+
+  void invalidate(const Rect& r) {
+    if (invalidate_ && !empty(r)) invalidate_(r);
+  }
+
+  // Grid cells of kCellSize; buttons covering more than kMaxCellsPerButton
+  // cells go to large_ instead.
+  static constexpr float kCellSize = 64.f;
+  static constexpr int kMaxCellsPerButton = 64;
+
+  static int cell_of(float v) { return (int)std::floor(v / kCellSize); }
+  static std::uint64_t key(int cx, int cy) {
+    return ((std::uint64_t)(std::uint32_t)cx << 32) | (std::uint32_t)cy;
+  }
+
+  // Calls f(cells_ entry) for every cell r covers; false if r is large.
+  template <class F>
+  bool for_cells(const Rect& r, F&& f) {
+    const int x0 = cell_of(r.x), y0 = cell_of(r.y), x1 = cell_of(r.x + r.w), y1 = cell_of(r.y + r.h);
+    if ((std::int64_t)(x1 - x0 + 1) * (y1 - y0 + 1) > kMaxCellsPerButton) return false;
+    for (int cy = y0; cy <= y1; ++cy)
+      for (int cx = x0; cx <= x1; ++cx) f(key(cx, cy));
+    return true;
+  }
+
+  void index_insert(id b) {
+    const Rect& r = rects_[b];
+    if (empty(r)) return;
+    if (!for_cells(r, [&](std::uint64_t k) { cells_[k].push_back(b); })) large_.push_back(b);
+  }
+
+  void index_erase(id b) {
+    const Rect& r = rects_[b];
+    if (empty(r)) return;
+    auto drop = [b](std::vector<id>& v) {
+      auto it = std::find(v.begin(), v.end(), b);
+      if (it != v.end()) { *it = v.back(); v.pop_back(); }
+    };
+    const bool small = for_cells(r, [&](std::uint64_t k) {
+      auto it = cells_.find(k);
+      if (it == cells_.end()) return;
+      drop(it->second);
+      if (it->second.empty()) cells_.erase(it);
+    });
+    if (!small) drop(large_);
+  }
+
+  // Re-interns the live labels into a fresh pool. Amortized O(1) per label
+  // change: the next compaction waits until the pool doubles again.
+  void compact_labels_if_needed() {
+    if (labels_.bytes() <= compact_at_) return;
+    spare_labels_.clear();
+    for (TextPool::handle& t : text_) t = spare_labels_.intern(labels_.view(t));
+    std::swap(labels_, spare_labels_);
+    spare_labels_.clear(); // keeps its capacity for the next compaction
+    compact_at_ = std::max(kMinCompactBytes, 2 * labels_.bytes());
+  }
+
+  static constexpr std::size_t kMinCompactBytes = 4096;
+
+  // One entry per button
+  std::vector<Rect> rects_;
+  std::vector<std::uint8_t> state_;
+  std::vector<style_id> style_;
+  std::vector<TextPool::handle> text_;
+  std::vector<handler_id> handler_;
+
+  // Shared tables
+  std::vector<ButtonStyle> styles_;
+  std::deque<Handler> handlers_; // stable: handlers may add handlers
+  TextPool labels_;
+  TextPool spare_labels_;
+  std::size_t compact_at_{kMinCompactBytes};
+
+  // Hit test index
+  std::unordered_map<std::uint64_t, std::vector<id>> cells_;
+  std::vector<id> large_;
+
+  id hovered_{kNone};
+  id pressed_{kNone};
+  std::function<void(Rect)> invalidate_;
+  std::vector<id> todo_;
+  std::vector<float> line_height_;
+};
+
+} // namespace pulseui::ui
@@ -2,6 +2,7 @@
 #include <functional>
 #include <string>
 #include <memory>
+#include <span>
 #include <pulseui/ui/canvas.hpp>
 #include <pulseui/ui/input.hpp>
 
@@ -9,11 +10,26 @@ namespace pulseui::ui {
   struct Window {
     using PaintCB = std::function<void(Canvas&)>;
     using InputCB = std::function<void(const InputEvent&)>;
+    using InputBatchCB = std::function<void(std::span<const InputEvent>)>;
     virtual ~Window() = default;
     virtual void set_title(std::string) = 0;
     virtual void invalidate() = 0;
+    // Adds r to the damage region; only the damaged area is repainted.
+    virtual void invalidate(Rect r) = 0;
+    // Moves what is already painted in area by (dx, dy) and damages the part
+    // of area left uncovered; pending damage inside area moves along.
+    // Backends that cannot blit repaint area instead.
+    virtual void scroll(Rect area, float dx, float dy) { (void)dx; (void)dy; invalidate(area); }
     virtual float dpi_scale() const = 0;
     virtual void on_paint(PaintCB) = 0;
     virtual void on_input(InputCB) = 0;
+    // Coalesced events (see InputQueue), delivered at most once per frame.
+    virtual void on_input_batch(InputBatchCB) = 0;
+    // Keeps every raw MouseMove behind a batch, not just the last one
+    // (drawing tools want the full path). Off by default.
+    virtual void set_keep_move_history(bool on) { (void)on; }
+    // Inside an on_input_batch callback: the raw moves of that batch, oldest
+    // first. Empty unless set_keep_move_history(true).
+    virtual std::span<const InputEvent> move_history() const { return {}; }
   };
 }
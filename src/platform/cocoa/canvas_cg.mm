@@ -1,30 +1,81 @@
 #import <Cocoa/Cocoa.h>
 #import <CoreGraphics/CoreGraphics.h>
+#import <CoreText/CoreText.h>
 #include <memory>
 #include <string_view>
+#include <utility>
 
+#include <pulseui/platform/platform.hpp>
 #include <pulseui/ui/canvas.hpp>
+#include <pulseui/ui/image_cache.hpp>
 #include <pulseui/ui/input.hpp>
+#include <pulseui/ui/region.hpp>
+#include <pulseui/ui/text_cache.hpp>
 
 namespace {
 
+// Laid-out line; the color comes from the context's fill color, so one run
+// serves every color.
+struct CTTextRun {
+  CTLineRef line{nullptr};
+  pulseui::ui::TextMetrics metrics;
+  std::size_t size{0};
+
+  CTTextRun() = default;
+  CTTextRun(CTTextRun&& o) noexcept
+    : line(std::exchange(o.line, nullptr)), metrics(o.metrics), size(o.size) {}
+  CTTextRun& operator=(CTTextRun&&) = delete;
+  ~CTTextRun() { if (line) CFRelease(line); }
+
+  std::size_t bytes() const { return size; }
+};
+
+// CGImage over a ui::Surface's pixels (no copy), kept in Surface::native.
+// The data provider holds the pixel owner, so the image stays valid for as
+// long as CoreGraphics keeps it.
+struct CGSurfaceImage {
+  CGImageRef image{nullptr};
+  ~CGSurfaceImage() { if (image) CGImageRelease(image); }
+
+  static std::shared_ptr<CGSurfaceImage> make(const pulseui::ui::Surface& s) {
+    auto* owner = new std::shared_ptr<const void>(s.owner);
+    CGDataProviderRef provider = CGDataProviderCreateWithData(
+      owner, s.pixels, s.stride * 4 * (std::size_t)s.height,
+      [](void* info, const void*, std::size_t) { delete static_cast<std::shared_ptr<const void>*>(info); });
+    if (!provider) { delete owner; return nullptr; }
+    CGColorSpaceRef space = CGColorSpaceCreateWithName(kCGColorSpaceSRGB);
+    auto img = std::make_shared<CGSurfaceImage>();
+    // Straight alpha, bytes R,G,B,A in memory.
+    img->image = CGImageCreate(s.width, s.height, 8, 32, s.stride * 4, space,
+                               kCGImageAlphaLast | kCGBitmapByteOrderDefault, provider, nullptr, false,
+                               kCGRenderingIntentDefault);
+    CGColorSpaceRelease(space);
+    CGDataProviderRelease(provider);
+    return img->image ? img : nullptr;
+  }
+};
+
+pulseui::ui::TextCache<CTTextRun>& text_cache() {
+  static pulseui::ui::TextCache<CTTextRun> cache;
+  return cache;
+}
+
 class CanvasCG final : public pulseui::ui::Canvas {
 public:
-  CanvasCG(CGContextRef ctx, float dpi) : ctx_(ctx), dpi_(dpi) {}
+  CanvasCG(CGContextRef ctx, float dpi, const pulseui::ui::Region* damage)
+    : ctx_(ctx), dpi_(dpi), damage_(damage) {}
+
+  // AppKit already clips drawRect: to the dirty rects; this only exposes them.
+  const pulseui::ui::Region* damage() const override { return damage_; }
 
   void clear(pulseui::ui::Color c) override {
-    CGContextSaveGState(ctx_);
-    CGContextSetRGBFillColor(ctx_, c.r, c.g, c.b, c.a);
-    CGRect r = CGContextGetClipBoundingBox(ctx_);
-    CGContextFillRect(ctx_, r);
-    CGContextRestoreGState(ctx_);
+    set_fill(c);
+    CGContextFillRect(ctx_, CGContextGetClipBoundingBox(ctx_));
   }
 
   void fill_rect(pulseui::ui::Rect r, pulseui::ui::Color c) override {
-    CGContextSaveGState(ctx_);
-    CGContextSetRGBFillColor(ctx_, c.r, c.g, c.b, c.a);
+    set_fill(c);
     CGContextFillRect(ctx_, CGRectMake(r.x, r.y, r.w, r.h));
-    CGContextRestoreGState(ctx_);
   }
 
   void draw_text(pulseui::ui::Point p,
@@ -32,27 +83,87 @@ public:
                  const pulseui::ui::Font& f,
                  pulseui::ui::Color c) override
   {
-    @autoreleasepool {
-      NSDictionary* attrs = @{
-        NSFontAttributeName: [NSFont systemFontOfSize:f.size],
-        NSForegroundColorAttributeName: [NSColor colorWithCalibratedRed:c.r green:c.g blue:c.b alpha:c.a]
-      };
-      NSString* ns = [[NSString alloc] initWithBytes:text.data()
-                                              length:text.size()
-                                            encoding:NSUTF8StringEncoding];
-      [ns drawAtPoint:NSMakePoint(p.x, p.y) withAttributes:attrs];
-    }
+    const CTTextRun& run = text_run(text, f);
+    if (!run.line) return;
+    set_fill(c);
+    // The view is flipped; CoreText draws upright at the baseline.
+    CGContextSetTextMatrix(ctx_, CGAffineTransformMakeScale(1, -1));
+    CGContextSetTextPosition(ctx_, p.x, p.y + run.metrics.ascent);
+    CTLineDraw(run.line, ctx_);
+  }
+
+  void draw_image(pulseui::ui::Rect dst, const pulseui::ui::Image& img, float opacity) override {
+    if (!img || dst.w <= 0 || dst.h <= 0) return;
+    const auto s = pulseui::ui::surface_cache().get(img, dst, dpi_);
+    if (!s) return;
+    if (!s->native) s->native = CGSurfaceImage::make(*s);
+    auto* cg = static_cast<CGSurfaceImage*>(s->native.get());
+    if (!cg) return;
+    // The view is flipped and CGContextDrawImage draws y-up, so flip around dst.
+    CGContextSaveGState(ctx_);
+    CGContextSetAlpha(ctx_, opacity < 0.f ? 0.f : (opacity > 1.f ? 1.f : opacity));
+    CGContextSetInterpolationQuality(ctx_, kCGInterpolationMedium);
+    CGContextTranslateCTM(ctx_, dst.x, dst.y + dst.h);
+    CGContextScaleCTM(ctx_, 1, -1);
+    CGContextDrawImage(ctx_, CGRectMake(0, 0, dst.w, dst.h), cg->image);
+    CGContextRestoreGState(ctx_);
+  }
+
+  float dpi_scale() const override { return dpi_; }
+
+  pulseui::ui::TextMetrics measure_text(std::string_view text, const pulseui::ui::Font& f) override {
+    return text_run(text, f).metrics;
   }
 
 private:
+  // The fill color is the only context state the canvas touches, so instead
+  // of saving/restoring the gstate per call it is set only when it changes.
+  void set_fill(const pulseui::ui::Color& c) {
+    if (has_fill_ && c.r == fill_.r && c.g == fill_.g && c.b == fill_.b && c.a == fill_.a) return;
+    CGContextSetRGBFillColor(ctx_, c.r, c.g, c.b, c.a);
+    fill_ = c;
+    has_fill_ = true;
+  }
+
+  const CTTextRun& text_run(std::string_view text, const pulseui::ui::Font& f) {
+    return text_cache().get(text, f, dpi_, [&](std::string_view t) {
+      CTTextRun run;
+      @autoreleasepool {
+        NSString* ns = [[NSString alloc] initWithBytes:t.data()
+                                                length:t.size()
+                                              encoding:NSUTF8StringEncoding];
+        if (!ns) ns = @"";
+        NSDictionary* attrs = @{
+          NSFontAttributeName: [NSFont systemFontOfSize:f.size],
+          (__bridge NSString*)kCTForegroundColorFromContextAttributeName: @YES
+        };
+        NSAttributedString* as = [[NSAttributedString alloc] initWithString:ns attributes:attrs];
+        run.line = CTLineCreateWithAttributedString((__bridge CFAttributedStringRef)as);
+      }
+      CGFloat ascent = 0, descent = 0, leading = 0;
+      const double width = CTLineGetTypographicBounds(run.line, &ascent, &descent, &leading);
+      run.metrics = pulseui::ui::TextMetrics{(float)width, (float)ascent, (float)descent};
+      run.size    = 256 + t.size() * 32; // rough: line + glyph runs
+      return run;
+    });
+  }
+
   CGContextRef ctx_;
   float dpi_{1.f};
+  const pulseui::ui::Region* damage_{nullptr};
+  pulseui::ui::Color fill_{};
+  bool has_fill_{false};
 };
 
 } // namespace
 
 namespace pulseui::ui {
-  std::unique_ptr<Canvas> make_canvas_from_context(CGContextRef ctx, float dpi_scale) {
-    return std::make_unique<CanvasCG>(ctx, dpi_scale);
+  std::unique_ptr<Canvas> make_canvas_from_context(CGContextRef ctx, float dpi_scale,
+                                                   const Region* damage) {
+    return std::make_unique<CanvasCG>(ctx, dpi_scale, damage);
   }
 }
+
+namespace pulseui::platform {
+  ui::TextCacheStats text_cache_stats() { return text_cache().stats(); }
+}
@@ -1,17 +1,39 @@
 #import <Foundation/Foundation.h>
 #include <memory>
-#include <queue>
-#include <mutex>
-#include <functional>
+#include <cstdint>
+#include <new>
 #include <pulseui/core/executor.hpp>
+#include <pulseui/core/profiler.hpp>
+#include <pulseui/core/task.hpp>
 
 namespace pulseui::platform {
   class CocoaExecutor final : public pulseui::core::executor {
   public:
-    void post(std::function<void()> fn) override {
-      // Dispatch to main queue
-      auto blockFn = [fn = std::move(fn)](){ fn(); };
-      dispatch_async(dispatch_get_main_queue(), blockFn);
+    using pulseui::core::executor::post;
+    void post(pulseui::core::task t) override {
+      // Dispatch to main queue: the task is moved once into a pooled block and
+      // handed to GCD as a plain context pointer (no block copy, no std::function).
+      void* mem = TaskPool::allocate();
+      auto* boxed = ::new (mem) queued{std::move(t), PULSEUI_PROFILE_NOW()};
+      dispatch_async_f(dispatch_get_main_queue(), boxed, &CocoaExecutor::run);
+    }
+
+  private:
+    struct queued {
+      pulseui::core::task fn;
+      std::uint64_t posted_ns; // 0 unless profiling
+    };
+    using TaskPool = pulseui::core::detail::block_pool<sizeof(queued)>;
+
+    static void run(void* ctx) {
+      auto* q = static_cast<queued*>(ctx);
+      struct Release {
+        queued* q;
+        ~Release() { q->~queued(); TaskPool::deallocate(q); }
+      } release{q};
+      PULSEUI_PROFILE_SINCE("task.wait", q->posted_ns);
+      PULSEUI_PROFILE_SCOPE("task");
+      if (q->fn) q->fn();
     }
   };
 
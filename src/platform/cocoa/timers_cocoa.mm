@@ -1,4 +1,5 @@
 #import <Foundation/Foundation.h>
 namespace pulseui::platform {
-// Placeholder: platform timers if needed separately (GCD timers).
+// Timers are shared through core::timer_service (see platform/timing.hpp);
+// its driver thread posts to the main queue like any other UI task.
 }
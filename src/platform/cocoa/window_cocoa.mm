@@ -4,12 +4,16 @@
 #include <memory>
 #include <string>
 
+#include <pulseui/core/profiler.hpp>
 #include <pulseui/ui/window.hpp>
 #include <pulseui/ui/input.hpp>
+#include <pulseui/ui/input_queue.hpp>
 #include <pulseui/ui/canvas.hpp>
+#include <pulseui/ui/region.hpp>
 
 namespace pulseui::ui {
-  std::unique_ptr<Canvas> make_canvas_from_context(CGContextRef, float dpi_scale);
+  std::unique_ptr<Canvas> make_canvas_from_context(CGContextRef, float dpi_scale,
+                                                   const Region* damage = nullptr);
 }
 
 using pulseui::ui::Canvas;
@@ -19,9 +23,15 @@ using pulseui::ui::InputEvent;
 @public
   std::function<void(Canvas&)>* paintCB;
   std::function<void(const InputEvent&)>* inputCB;
+  std::function<void(std::span<const InputEvent>)>* inputBatchCB;
+  pulseui::ui::InputQueue inputQueue;
+  BOOL inputFlushScheduled;
   float dpiScale;
+  pulseui::ui::Region paintDamage;
 }
 - (void)emitMouse:(InputEvent::Type)type fromEvent:(NSEvent*)e;
+- (void)emitEvent:(const InputEvent&)ev;
+- (void)flushInput;
 @end
 
 @implementation PulseView
@@ -31,6 +41,8 @@ using pulseui::ui::InputEvent;
   if (self = [super initWithFrame:frameRect]) {
     paintCB = nullptr;
     inputCB = nullptr;
+    inputBatchCB = nullptr;
+    inputFlushScheduled = NO;
     self.wantsLayer = YES;
     if (!self.layer) self.layer = [CALayer layer];
     CGFloat s = NSScreen.mainScreen.backingScaleFactor; if (s <= 0) s = 1.0;
@@ -45,16 +57,59 @@ using pulseui::ui::InputEvent;
 - (void)drawRect:(NSRect)dirtyRect {
   [super drawRect:dirtyRect];
   if (!paintCB) return;
+  PULSEUI_PROFILE_SCOPE("paint");
   CGContextRef ctx = (CGContextRef)[[NSGraphicsContext currentContext] CGContext];
-  auto canvas = pulseui::ui::make_canvas_from_context(ctx, dpiScale);
+
+  const NSRect* rects = nullptr;
+  NSInteger count = 0;
+  [self getRectsBeingDrawn:&rects count:&count];
+  paintDamage.clear();
+  for (NSInteger i = 0; i < count; ++i) {
+    paintDamage.add(pulseui::ui::Rect{(float)rects[i].origin.x, (float)rects[i].origin.y,
+                                      (float)rects[i].size.width, (float)rects[i].size.height});
+  }
+  const bool partial = !paintDamage.empty() && !NSContainsRect(NSMakeRect(
+      paintDamage.bounds().x, paintDamage.bounds().y,
+      paintDamage.bounds().w, paintDamage.bounds().h), self.bounds);
+
+  auto canvas = pulseui::ui::make_canvas_from_context(ctx, dpiScale,
+                                                      partial ? &paintDamage : nullptr);
   (*paintCB)(*canvas);
+  pulseui::ui::paint_arena().reset();
 }
 
 - (void)emitMouse:(InputEvent::Type)type fromEvent:(NSEvent*)e {
-  if (!inputCB) return;
   NSPoint p = [self convertPoint:e.locationInWindow fromView:nil];
   InputEvent ev{}; ev.type = type; ev.pos = {(float)p.x, (float)p.y};
-  (*inputCB)(ev);
+  [self emitEvent:ev];
+}
+
+- (void)emitEvent:(const InputEvent&)event {
+  InputEvent ev = event;
+  ev.timestamp = pulseui::ui::input_timestamp();
+  if (inputCB && *inputCB) (*inputCB)(ev);
+  if (!inputBatchCB || !*inputBatchCB) return;
+  inputQueue.push(ev);
+  // Runs after the events already waiting in this run loop pass.
+  if (!inputFlushScheduled) {
+    inputFlushScheduled = YES;
+    [self performSelector:@selector(flushInput) withObject:nil afterDelay:0];
+  }
+}
+
+- (void)flushInput {
+  PULSEUI_PROFILE_SCOPE("input");
+  inputFlushScheduled = NO;
+  inputQueue.flush([&](std::span<const InputEvent> batch) {
+    if (inputBatchCB && *inputBatchCB) (*inputBatchCB)(batch);
+  });
+}
+
+- (void)scrollWheel:(NSEvent *)e {
+  NSPoint p = [self convertPoint:e.locationInWindow fromView:nil];
+  InputEvent ev{}; ev.type = InputEvent::Scroll; ev.pos = {(float)p.x, (float)p.y};
+  ev.scrollY = (float)e.scrollingDeltaY;
+  [self emitEvent:ev];
 }
 
 - (void)mouseMoved:(NSEvent *)e   { [self emitMouse:InputEvent::MouseMove fromEvent:e]; }
@@ -87,8 +142,10 @@ public:
 
       paint_holder_ = std::make_unique<std::function<void(Canvas&)>>();
       input_holder_ = std::make_unique<std::function<void(const InputEvent&)>>();
+      batch_holder_ = std::make_unique<InputBatchCB>();
       view_->paintCB = paint_holder_.get();
       view_->inputCB = input_holder_.get();
+      view_->inputBatchCB = batch_holder_.get();
 
       *paint_holder_ = [](Canvas&){};
       *input_holder_ = [](const InputEvent&){};
@@ -97,7 +154,10 @@ public:
 
   ~CocoaWindow() override {
     @autoreleasepool {
-      if (view_) { view_->paintCB = nullptr; view_->inputCB = nullptr; }
+      if (view_) {
+        [NSObject cancelPreviousPerformRequestsWithTarget:view_];
+        view_->paintCB = nullptr; view_->inputCB = nullptr; view_->inputBatchCB = nullptr;
+      }
       if (window_) { [window_ orderOut:nil]; [window_ close]; }
       view_ = nil; window_ = nil;
     }
@@ -111,6 +171,14 @@ public:
     @autoreleasepool { [view_ setNeedsDisplay:YES]; }
   }
 
+  void invalidate(Rect r) override {
+    // AppKit accumulates the dirty rects; drawRect: reads them back.
+    @autoreleasepool { [view_ setNeedsDisplayInRect:NSMakeRect(r.x, r.y, r.w, r.h)]; }
+  }
+
+  // No scroll() override: PulseView is layer-backed, and scrollRect:by: does
+  // not move a layer's pixels, so Window's default repaints the area.
+
   float dpi_scale() const override {
     @autoreleasepool {
       CGFloat s = window_.screen.backingScaleFactor; if (s <= 0) s = 1.0;
@@ -120,12 +188,18 @@ public:
 
   void on_paint(PaintCB cb) override { *paint_holder_ = std::move(cb); [view_ setNeedsDisplay:YES]; }
   void on_input(InputCB cb) override { *input_holder_ = std::move(cb); }
+  void on_input_batch(InputBatchCB cb) override { *batch_holder_ = std::move(cb); }
+  void set_keep_move_history(bool on) override { view_->inputQueue.set_keep_move_history(on); }
+  std::span<const InputEvent> move_history() const override {
+    return view_->inputQueue.delivered_move_history();
+  }
 
 private:
   NSWindow*  window_{nil};
   PulseView* view_{nil};
   std::unique_ptr<std::function<void(Canvas&)>>           paint_holder_;
   std::unique_ptr<std::function<void(const InputEvent&)>> input_holder_;
+  std::unique_ptr<InputBatchCB>                           batch_holder_;
 };
 
 } // namespace pulseui::ui
@@ -0,0 +1,15 @@
+#include <pulseui/platform/platform.hpp>
+#include <pulseui/platform/headless.hpp>
+#include <memory>
+#include <string>
+
+namespace pulseui::platform {
+
+std::unique_ptr<core::executor> make_headless_executor();
+
+std::unique_ptr<core::executor> make_ui_executor() { return make_headless_executor(); }
+std::unique_ptr<ui::Window>     make_window(int w, int h, const std::string& title) {
+  return make_headless_window(w, h, title);
+}
+
+} // namespace pulseui::platform
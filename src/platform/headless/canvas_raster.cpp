@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <pulseui/platform/headless.hpp>
+#include <pulseui/platform/platform.hpp>
+#include <pulseui/ui/image_cache.hpp>
+#include <pulseui/ui/text_cache.hpp>
+#include "raster_image.hpp"
+#include "raster_kernels.hpp"
+#include "raster_text.hpp"
+
+namespace pulseui::platform {
+
+namespace {
+inline int to_px(float v) { return (int)std::lroundf(v); }
+
+ui::TextCache<raster::GlyphRun>& text_cache() {
+  static ui::TextCache<raster::GlyphRun> cache;
+  return cache;
+}
+} // namespace
+
+namespace raster {
+GlyphRun layout(std::string_view text, const ui::Font& f) {
+  GlyphRun run;
+  const float advance = f.size * 0.5f;
+  float x = 0.f;
+  for (unsigned char ch : text) {
+    if ((ch & 0xC0) == 0x80) continue; // UTF-8 continuation byte
+    if (ch != ' ') run.glyphs.push_back(x);
+    x += advance;
+  }
+  run.metrics = ui::TextMetrics{x, f.size * 0.8f, f.size * 0.2f};
+  return run;
+}
+
+const GlyphRun& shape(std::string_view text, const ui::Font& f) { return shape(text, f, text_cache()); }
+
+const GlyphRun& shape(std::string_view text, const ui::Font& f, ui::TextCache<GlyphRun>& cache) {
+  return cache.get(text, f, 1.f, [&](std::string_view t) { return layout(t, f); });
+}
+} // namespace raster
+
+RasterCanvas::RasterCanvas(Framebuffer& fb) : fb_(fb) { reset_clip(); }
+
+void RasterCanvas::set_clip(ui::Rect r) {
+  clip_.x0 = std::clamp(to_px(r.x), 0, fb_.width);
+  clip_.y0 = std::clamp(to_px(r.y), 0, fb_.height);
+  clip_.x1 = std::clamp(to_px(r.x + r.w), clip_.x0, fb_.width);
+  clip_.y1 = std::clamp(to_px(r.y + r.h), clip_.y0, fb_.height);
+  update_boxes();
+}
+
+void RasterCanvas::reset_clip() {
+  clip_ = Box{0, 0, fb_.width, fb_.height};
+  update_boxes();
+}
+
+void RasterCanvas::set_damage(const ui::Region* d) {
+  damage_ = d;
+  update_boxes();
+}
+
+void RasterCanvas::update_boxes() {
+  box_count_ = 0;
+  auto push = [&](Box b) {
+    b.x0 = std::max(b.x0, clip_.x0);
+    b.y0 = std::max(b.y0, clip_.y0);
+    b.x1 = std::min(b.x1, clip_.x1);
+    b.y1 = std::min(b.y1, clip_.y1);
+    if (b.x0 < b.x1 && b.y0 < b.y1 && box_count_ < boxes_.size()) boxes_[box_count_++] = b;
+  };
+  if (!damage_) { push(clip_); return; }
+  // Region rects are disjoint and share rounded edges, so the boxes stay disjoint.
+  for (const ui::Rect& r : damage_->rects()) {
+    push(Box{to_px(r.x), to_px(r.y), to_px(r.x + r.w), to_px(r.y + r.h)});
+  }
+}
+
+void RasterCanvas::fill_pixels(int x0, int y0, int x1, int y1, std::uint32_t px) {
+  const bool opaque = (px >> 24) == 0xFF;
+  for (std::size_t i = 0; i < box_count_; ++i) {
+    const Box& b = boxes_[i];
+    const int bx0 = std::max(x0, b.x0), by0 = std::max(y0, b.y0);
+    const int bx1 = std::min(x1, b.x1), by1 = std::min(y1, b.y1);
+    if (bx0 >= bx1 || by0 >= by1) continue;
+
+    const auto n = (std::size_t)(bx1 - bx0);
+    if (opaque) {
+      for (int y = by0; y < by1; ++y) raster::fill_span(fb_.row(y) + bx0, n, px);
+    } else {
+      for (int y = by0; y < by1; ++y) raster::blend_span(fb_.row(y) + bx0, n, px);
+    }
+  }
+}
+
+void RasterCanvas::clear(ui::Color c) {
+  // Like the native backends, clear replaces the clipped area instead of blending.
+  const std::uint32_t px = to_rgba8(c);
+  for (std::size_t i = 0; i < box_count_; ++i) {
+    const Box& b = boxes_[i];
+    for (int y = b.y0; y < b.y1; ++y) {
+      raster::fill_span(fb_.row(y) + b.x0, (std::size_t)(b.x1 - b.x0), px);
+    }
+  }
+}
+
+void RasterCanvas::fill_rect(ui::Rect r, ui::Color c) {
+  fill_pixels(to_px(r.x), to_px(r.y), to_px(r.x + r.w), to_px(r.y + r.h), to_rgba8(c));
+}
+
+void RasterCanvas::draw_text(ui::Point p, std::string_view text, const ui::Font& f, ui::Color c) {
+  const std::uint32_t px = to_rgba8(c);
+  for (float gx : raster::shape(text, f).glyphs) {
+    const raster::GlyphBox g = raster::glyph_box(p, gx, f);
+    fill_pixels(g.x0, g.y0, g.x1, g.y1, px);
+  }
+}
+
+void RasterCanvas::draw_image(ui::Rect dst, const ui::Image& img, float opacity) {
+  if (!img || dst.w <= 0 || dst.h <= 0) return;
+  const ui::SurfaceCache::SurfacePtr s = ui::surface_cache().get(img, dst, dpi_scale());
+  raster::ImageBlit b;
+  if (!s || !raster::image_blit(dst, *s, opacity, b)) return;
+  for (std::size_t i = 0; i < box_count_; ++i) {
+    const Box& box = boxes_[i];
+    raster::draw_image(fb_, b, box.x0, box.y0, box.x1, box.y1);
+  }
+}
+
+ui::TextMetrics RasterCanvas::measure_text(std::string_view text, const ui::Font& f) {
+  return raster::shape(text, f).metrics;
+}
+
+ui::TextCacheStats text_cache_stats() { return text_cache().stats(); }
+
+const char* raster_simd_level() { return raster::simd_level(); }
+
+} // namespace pulseui::platform
@@ -0,0 +1,60 @@
+#include <algorithm>
+#include <memory>
+
+#include <pulseui/core/executor.hpp>
+#include <pulseui/platform/headless.hpp>
+#include "run_loop.hpp"
+
+namespace pulseui::platform {
+
+RunLoop& RunLoop::instance() {
+  static RunLoop loop;
+  return loop;
+}
+
+void RunLoop::add_window(HeadlessWindow* w) { windows_.push_back(w); }
+
+void RunLoop::remove_window(HeadlessWindow* w) {
+  windows_.erase(std::remove(windows_.begin(), windows_.end(), w), windows_.end());
+}
+
+bool RunLoop::run_pending() {
+  bool worked = tasks_.run_pending() > 0;
+
+  // One frame: coalesced input first, then paint. Index loops, since the
+  // callbacks may create or destroy windows.
+  for (std::size_t i = 0; i < windows_.size(); ++i) {
+    if (windows_[i]->flush_input()) worked = true;
+  }
+  for (std::size_t i = 0; i < windows_.size(); ++i) {
+    if (windows_[i]->paint_if_needed()) worked = true;
+  }
+  return worked;
+}
+
+void RunLoop::run() {
+  while (!quit_.load(std::memory_order_acquire)) {
+    if (!run_pending()) tasks_.wait();
+  }
+  quit_.store(false, std::memory_order_relaxed);
+}
+
+void RunLoop::quit() {
+  quit_.store(true, std::memory_order_release);
+  wake();
+}
+
+bool run_pending() { return RunLoop::instance().run_pending(); }
+
+class HeadlessExecutor final : public core::executor {
+public:
+  // === core::executor override ===
+  using core::executor::post;
+  void post(core::task t) override { RunLoop::instance().post(std::move(t)); }
+};
+
+std::unique_ptr<core::executor> make_headless_executor() {
+  return std::make_unique<HeadlessExecutor>();
+}
+
+} // namespace pulseui::platform
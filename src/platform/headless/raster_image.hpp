@@ -0,0 +1,47 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <pulseui/platform/headless.hpp>
+#include <pulseui/ui/image.hpp>
+#include "raster_kernels.hpp"
+
+namespace pulseui::platform::raster {
+
+// A draw_image resolved to pixels: the destination box (edges rounded like
+// fills, not yet clipped) and 16.16 source steps per destination pixel.
+struct ImageBlit {
+  int x0, y0, x1, y1;
+  std::uint32_t step_x, step_y;
+  std::uint32_t opacity; // 0..255
+  const ui::Surface* src;
+};
+
+// False when nothing would be drawn.
+inline bool image_blit(ui::Rect dst, const ui::Surface& s, float opacity, ImageBlit& out) {
+  out.x0 = (int)std::lroundf(dst.x);
+  out.y0 = (int)std::lroundf(dst.y);
+  out.x1 = (int)std::lroundf(dst.x + dst.w);
+  out.y1 = (int)std::lroundf(dst.y + dst.h);
+  out.opacity = (std::uint32_t)(std::clamp(opacity, 0.f, 1.f) * 255.f + 0.5f);
+  out.src = &s;
+  if (out.x0 >= out.x1 || out.y0 >= out.y1 || out.opacity == 0 || s.width <= 0 || s.height <= 0) return false;
+  out.step_x = (std::uint32_t)(((std::uint64_t)s.width << 16) / (std::uint64_t)(out.x1 - out.x0));
+  out.step_y = (std::uint32_t)(((std::uint64_t)s.height << 16) / (std::uint64_t)(out.y1 - out.y0));
+  return true;
+}
+
+// Draws the part of b inside [cx0, cx1) x [cy0, cy1), sampling pixel centers.
+inline void draw_image(Framebuffer& fb, const ImageBlit& b, int cx0, int cy0, int cx1, int cy1) {
+  const int x0 = std::max(b.x0, cx0), y0 = std::max(b.y0, cy0);
+  const int x1 = std::min(b.x1, cx1), y1 = std::min(b.y1, cy1);
+  if (x0 >= x1 || y0 >= y1) return;
+  const auto fx = (std::uint32_t)((std::uint64_t)(x0 - b.x0) * b.step_x + b.step_x / 2);
+  for (int y = y0; y < y1; ++y) {
+    const auto fy = (std::uint64_t)(y - b.y0) * b.step_y + b.step_y / 2;
+    const int sy = std::min((int)(fy >> 16), b.src->height - 1);
+    blend_image_span(fb.row(y) + x0, (std::size_t)(x1 - x0), b.src->row(sy), fx, b.step_x, b.opacity);
+  }
+}
+
+} // namespace pulseui::platform::raster
@@ -0,0 +1,124 @@
+#include "raster_kernels.hpp"
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+  #define PULSEUI_RASTER_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define PULSEUI_RASTER_SSE2 1
+#endif
+
+namespace pulseui::platform::raster {
+
+namespace {
+
+// x * k / 255 for one channel (k is usually 255 - a), exact for all 8-bit inputs.
+inline std::uint32_t mul_div255(std::uint32_t x, std::uint32_t k) {
+  const std::uint32_t t = x * k + 128;
+  return (t + (t >> 8)) >> 8;
+}
+
+inline std::uint32_t blend_px(std::uint32_t d, std::uint32_t s, std::uint32_t inv) {
+  const std::uint32_t r = (s & 0xFF)         + mul_div255(d & 0xFF, inv);
+  const std::uint32_t g = ((s >> 8) & 0xFF)  + mul_div255((d >> 8) & 0xFF, inv);
+  const std::uint32_t b = ((s >> 16) & 0xFF) + mul_div255((d >> 16) & 0xFF, inv);
+  const std::uint32_t a = (s >> 24)          + mul_div255(d >> 24, inv);
+  return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+#if PULSEUI_RASTER_SSE2
+// Same rounding as mul_div255 on eight 16-bit lanes.
+inline __m128i div255_epi16(__m128i x) {
+  x = _mm_add_epi16(x, _mm_set1_epi16(128));
+  return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+inline __m128i blend4(__m128i d, __m128i s, __m128i inv) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inv);
+  __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inv);
+  return _mm_adds_epu8(s, _mm_packus_epi16(div255_epi16(lo), div255_epi16(hi)));
+}
+#endif
+
+#if PULSEUI_RASTER_AVX2
+inline __m256i div255_epi16(__m256i x) {
+  x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+  return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+inline __m256i blend8(__m256i d, __m256i s, __m256i inv) {
+  const __m256i zero = _mm256_setzero_si256();
+  // unpack/pack both operate per 128-bit lane, so the pixel order round-trips.
+  __m256i lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), inv);
+  __m256i hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), inv);
+  return _mm256_adds_epu8(s, _mm256_packus_epi16(div255_epi16(lo), div255_epi16(hi)));
+}
+#endif
+
+} // namespace
+
+void fill_span(std::uint32_t* dst, std::size_t n, std::uint32_t px) {
+  std::size_t i = 0;
+#if PULSEUI_RASTER_AVX2
+  const __m256i v8 = _mm256_set1_epi32((int)px);
+  for (; i + 8 <= n; i += 8) _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v8);
+#endif
+#if PULSEUI_RASTER_SSE2
+  const __m128i v4 = _mm_set1_epi32((int)px);
+  for (; i + 4 <= n; i += 4) _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v4);
+#endif
+  for (; i < n; ++i) dst[i] = px;
+}
+
+void blend_span(std::uint32_t* dst, std::size_t n, std::uint32_t px) {
+  const std::uint32_t alpha = px >> 24;
+  if (alpha == 0xFF) { fill_span(dst, n, px); return; }
+  if (px == 0) return;
+
+  const std::uint32_t inv = 255 - alpha;
+  std::size_t i = 0;
+#if PULSEUI_RASTER_AVX2
+  const __m256i s8   = _mm256_set1_epi32((int)px);
+  const __m256i inv8 = _mm256_set1_epi16((short)inv);
+  for (; i + 8 <= n; i += 8) {
+    auto* p = reinterpret_cast<__m256i*>(dst + i);
+    _mm256_storeu_si256(p, blend8(_mm256_loadu_si256(p), s8, inv8));
+  }
+#endif
+#if PULSEUI_RASTER_SSE2
+  const __m128i s4   = _mm_set1_epi32((int)px);
+  const __m128i inv4 = _mm_set1_epi16((short)inv);
+  for (; i + 4 <= n; i += 4) {
+    auto* p = reinterpret_cast<__m128i*>(dst + i);
+    _mm_storeu_si128(p, blend4(_mm_loadu_si128(p), s4, inv4));
+  }
+#endif
+  for (; i < n; ++i) dst[i] = blend_px(dst[i], px, inv);
+}
+
+void blend_image_span(std::uint32_t* dst, std::size_t n, const std::uint32_t* src,
+                      std::uint32_t fx, std::uint32_t step, std::uint32_t opacity) {
+  for (std::size_t i = 0; i < n; ++i, fx += step) {
+    const std::uint32_t s = src[fx >> 16];
+    const std::uint32_t a = opacity == 255 ? s >> 24 : mul_div255(s >> 24, opacity);
+    if (a == 0) continue;
+    if (a == 255) { dst[i] = s | 0xFF000000u; continue; }
+    const std::uint32_t p = mul_div255(s & 0xFF, a) | mul_div255((s >> 8) & 0xFF, a) << 8 |
+                            mul_div255((s >> 16) & 0xFF, a) << 16 | a << 24;
+    dst[i] = blend_px(dst[i], p, 255 - a);
+  }
+}
+
+const char* simd_level() {
+#if PULSEUI_RASTER_AVX2
+  return "avx2";
+#elif PULSEUI_RASTER_SSE2
+  return "sse2";
+#else
+  return "scalar";
+#endif
+}
+
+} // namespace pulseui::platform::raster
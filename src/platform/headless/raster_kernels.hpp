@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace pulseui::platform::raster {
+
+// Writes n copies of px to dst.
+void fill_span(std::uint32_t* dst, std::size_t n, std::uint32_t px);
+
+// Source-over of a premultiplied RGBA8 pixel onto n destination pixels:
+//   dst = src + dst * (255 - src.a) / 255
+void blend_span(std::uint32_t* dst, std::size_t n, std::uint32_t px);
+
+// Source-over of straight-alpha RGBA8 image pixels onto n destination
+// pixels, sampling src[(fx + i * step) >> 16] (nearest, 16.16 fixed point).
+// opacity (0..255) scales the source alpha.
+void blend_image_span(std::uint32_t* dst, std::size_t n, const std::uint32_t* src,
+                      std::uint32_t fx, std::uint32_t step, std::uint32_t opacity);
+
+const char* simd_level();
+
+} // namespace pulseui::platform::raster
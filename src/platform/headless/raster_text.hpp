@@ -0,0 +1,38 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+#include <pulseui/ui/canvas.hpp>
+#include <pulseui/ui/text_cache.hpp>
+
+namespace pulseui::platform::raster {
+
+// "Shaped" run: the x offsets of the visible glyph boxes and the line extents.
+struct GlyphRun {
+  std::vector<float> glyphs;
+  ui::TextMetrics metrics;
+  std::size_t bytes() const { return glyphs.capacity() * sizeof(float); }
+};
+
+// Builds the run, uncached.
+GlyphRun layout(std::string_view text, const ui::Font& f);
+
+// Looks the run up in the backend's text cache (UI thread only: the cache is
+// not synchronized).
+const GlyphRun& shape(std::string_view text, const ui::Font& f);
+// Same with a caller-owned cache, for shaping off the UI thread.
+const GlyphRun& shape(std::string_view text, const ui::Font& f, ui::TextCache<GlyphRun>& cache);
+
+// Pixel box of the glyph at offset gx of a run drawn at p. There is no font
+// rasterizer here: each glyph is a solid box, so that text still costs fill
+// bandwidth roughly proportional to what a real backend pays.
+struct GlyphBox { int x0, y0, x1, y1; };
+
+inline GlyphBox glyph_box(ui::Point p, float gx, const ui::Font& f) {
+  const float x = p.x + gx;
+  return GlyphBox{(int)std::lroundf(x), (int)std::lroundf(p.y + f.size * 0.2f),
+                  (int)std::lroundf(x + f.size * 0.4f), (int)std::lroundf(p.y + f.size * 0.9f)};
+}
+
+} // namespace pulseui::platform::raster
@@ -0,0 +1,39 @@
+#pragma once
+#include <atomic>
+#include <vector>
+#include <pulseui/core/loop_executor.hpp>
+
+namespace pulseui::platform {
+
+class HeadlessWindow;
+
+// Process-wide stand-in for the OS message loop: every headless UI executor
+// posts here, and app_run()/run_pending() drain it on the UI thread.
+class RunLoop {
+public:
+  static RunLoop& instance();
+
+  void post(core::task t) { tasks_.post(std::move(t)); }
+
+  // Window registry; touched from the UI thread only.
+  void add_window(HeadlessWindow* w);
+  void remove_window(HeadlessWindow* w);
+
+  bool run_pending();
+
+  // Runs tasks and frames, sleeping while there are none, until quit().
+  void run();
+  // Any thread. Makes run() return after the current pass; a quit() before
+  // run() makes the next run() return right away.
+  void quit();
+  // Any thread: something other than a task (a window invalidation) needs
+  // the loop to make a pass.
+  void wake() { tasks_.notify(); }
+
+private:
+  core::loop_executor tasks_;
+  std::vector<HeadlessWindow*> windows_;
+  std::atomic<bool> quit_{false};
+};
+
+} // namespace pulseui::platform
@@ -0,0 +1,301 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <pulseui/platform/headless.hpp>
+#include <pulseui/ui/image_cache.hpp>
+#include "raster_image.hpp"
+#include "raster_kernels.hpp"
+#include "raster_text.hpp"
+
+namespace pulseui::platform {
+
+namespace {
+inline int to_px(float v) { return (int)std::lroundf(v); }
+
+constexpr std::uint32_t kNoBlit = 0xFFFFFFFFu;
+
+// A command resolved to pixels at bin time. Text keeps a range of glyph
+// boxes, images an index into the frame's blits.
+struct Op {
+  int x0, y0, x1, y1;          // bounds, clipped to the framebuffer
+  std::uint32_t px;
+  bool blend;                  // source-over, otherwise replace
+  std::uint32_t glyph_first{};
+  std::uint32_t glyph_count{}; // 0: solid box
+  std::uint32_t blit{kNoBlit};
+};
+
+// [begin, end) of work items packed into one word, so the owner can pop the
+// front and thieves the back, each with a single CAS.
+struct alignas(64) WorkRange {
+  std::atomic<std::uint64_t> v{0};
+
+  void reset(std::uint32_t b, std::uint32_t e) { v.store((std::uint64_t)e << 32 | b, std::memory_order_relaxed); }
+
+  bool pop_front(std::uint32_t& out) {
+    std::uint64_t cur = v.load(std::memory_order_relaxed);
+    for (;;) {
+      const auto b = (std::uint32_t)cur, e = (std::uint32_t)(cur >> 32);
+      if (b >= e) return false;
+      if (v.compare_exchange_weak(cur, (std::uint64_t)e << 32 | (b + 1), std::memory_order_relaxed)) {
+        out = b;
+        return true;
+      }
+    }
+  }
+
+  bool steal_back(std::uint32_t& out) {
+    std::uint64_t cur = v.load(std::memory_order_relaxed);
+    for (;;) {
+      const auto b = (std::uint32_t)cur, e = (std::uint32_t)(cur >> 32);
+      if (b >= e) return false;
+      if (v.compare_exchange_weak(cur, (std::uint64_t)(e - 1) << 32 | b, std::memory_order_relaxed)) {
+        out = e - 1;
+        return true;
+      }
+    }
+  }
+};
+} // namespace
+
+struct TileRasterizer::Impl {
+  int tile;
+  unsigned nthreads;
+  float dpi_scale{1.f};
+  TileStats stats;
+
+  // Frame being rendered (written by render() before the workers start)
+  Framebuffer* fb{nullptr};
+  int tiles_x{0}, tiles_y{0};
+  std::vector<Op> ops;
+  std::vector<raster::GlyphBox> glyphs;
+  std::vector<raster::ImageBlit> blits;
+  std::vector<ui::SurfaceCache::SurfacePtr> surfaces; // held for the frame
+
+  // Own caches: render() may run on any thread, and the global ones belong to
+  // the UI thread.
+  ui::TextCache<raster::GlyphRun> text_cache;
+  ui::SurfaceCache surface_cache;
+  std::vector<std::vector<std::uint32_t>> bins; // op indices per tile, in draw order
+  std::vector<std::uint32_t> work;              // non-empty tiles
+  std::vector<WorkRange> ranges;                // one per thread
+  std::atomic<std::uint64_t> stolen{0};
+
+  // Pool
+  std::vector<std::thread> workers;
+  std::mutex mx;
+  std::condition_variable start_cv, done_cv;
+  std::uint64_t generation{0}; // guarded by mx
+  unsigned running{0};         // guarded by mx
+  bool stopping{false};        // guarded by mx
+
+  Impl(unsigned threads, int tile_size)
+    : tile(tile_size > 0 ? tile_size : 128),
+      nthreads(threads ? threads : std::max(1u, std::thread::hardware_concurrency())),
+      ranges(nthreads) {
+    stats.threads = nthreads;
+    for (unsigned id = 1; id < nthreads; ++id) workers.emplace_back([this, id] { worker_main(id); });
+  }
+
+  ~Impl() {
+    {
+      std::lock_guard<std::mutex> lock(mx);
+      stopping = true;
+    }
+    start_cv.notify_all();
+    for (auto& t : workers) t.join();
+  }
+
+  void worker_main(unsigned id) {
+    std::uint64_t seen = 0;
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock(mx);
+        start_cv.wait(lock, [&] { return stopping || generation != seen; });
+        if (stopping) return;
+        seen = generation;
+      }
+      run(id);
+      std::lock_guard<std::mutex> lock(mx);
+      if (--running == 0) done_cv.notify_one();
+    }
+  }
+
+  // Own range first, then steal from the others until nothing is left.
+  void run(unsigned id) {
+    std::uint32_t item;
+    while (ranges[id].pop_front(item)) raster_tile(work[item]);
+    for (bool found = true; found;) {
+      found = false;
+      for (unsigned k = 1; k < nthreads; ++k) {
+        WorkRange& victim = ranges[(id + k) % nthreads];
+        while (victim.steal_back(item)) {
+          raster_tile(work[item]);
+          stolen.fetch_add(1, std::memory_order_relaxed);
+          found = true;
+        }
+      }
+    }
+  }
+
+  void raster_tile(std::uint32_t t) {
+    const int tx0 = (int)(t % (std::uint32_t)tiles_x) * tile, ty0 = (int)(t / (std::uint32_t)tiles_x) * tile;
+    const int tx1 = std::min(tx0 + tile, fb->width), ty1 = std::min(ty0 + tile, fb->height);
+    auto fill = [&](int x0, int y0, int x1, int y1, std::uint32_t px, bool blend) {
+      x0 = std::max(x0, tx0); y0 = std::max(y0, ty0);
+      x1 = std::min(x1, tx1); y1 = std::min(y1, ty1);
+      if (x0 >= x1 || y0 >= y1) return;
+      const auto n = (std::size_t)(x1 - x0);
+      if (blend) {
+        for (int y = y0; y < y1; ++y) raster::blend_span(fb->row(y) + x0, n, px);
+      } else {
+        for (int y = y0; y < y1; ++y) raster::fill_span(fb->row(y) + x0, n, px);
+      }
+    };
+    for (std::uint32_t i : bins[t]) {
+      const Op& op = ops[i];
+      if (op.blit != kNoBlit) {
+        raster::draw_image(*fb, blits[op.blit], tx0, ty0, tx1, ty1);
+        continue;
+      }
+      if (op.glyph_count == 0) {
+        fill(op.x0, op.y0, op.x1, op.y1, op.px, op.blend);
+        continue;
+      }
+      for (std::uint32_t g = op.glyph_first; g < op.glyph_first + op.glyph_count; ++g) {
+        const raster::GlyphBox& b = glyphs[g];
+        fill(b.x0, b.y0, b.x1, b.y1, op.px, op.blend);
+      }
+    }
+  }
+
+  void push(Op op) {
+    op.x0 = std::max(op.x0, 0);
+    op.y0 = std::max(op.y0, 0);
+    op.x1 = std::min(op.x1, fb->width);
+    op.y1 = std::min(op.y1, fb->height);
+    if (op.x0 >= op.x1 || op.y0 >= op.y1) return;
+    const auto index = (std::uint32_t)ops.size();
+    ops.push_back(op);
+    const int cx0 = op.x0 / tile, cy0 = op.y0 / tile;
+    const int cx1 = (op.x1 - 1) / tile, cy1 = (op.y1 - 1) / tile;
+    for (int cy = cy0; cy <= cy1; ++cy) {
+      for (int cx = cx0; cx <= cx1; ++cx) {
+        auto& bin = bins[(std::size_t)cy * tiles_x + cx];
+        // An opaque box covering the whole tile hides everything before it.
+        if (!op.blend && op.glyph_count == 0 && op.x0 <= cx * tile && op.y0 <= cy * tile &&
+            op.x1 >= std::min((cx + 1) * tile, fb->width) && op.y1 >= std::min((cy + 1) * tile, fb->height)) {
+          stats.discarded += bin.size();
+          bin.clear();
+        }
+        bin.push_back(index);
+        ++stats.binned;
+      }
+    }
+  }
+
+  void bin(const ui::DisplayList& list) {
+    ops.clear();
+    glyphs.clear();
+    blits.clear();
+    surfaces.clear();
+    tiles_x = (fb->width + tile - 1) / tile;
+    tiles_y = (fb->height + tile - 1) / tile;
+    bins.resize((std::size_t)tiles_x * tiles_y);
+    for (auto& b : bins) b.clear();
+
+    for (const ui::DrawCommand& cmd : list.commands()) {
+      const std::uint32_t px = to_rgba8(cmd.color);
+      switch (cmd.kind) {
+        case ui::DrawCommand::Clear:
+          push(Op{0, 0, fb->width, fb->height, px, false});
+          break;
+        case ui::DrawCommand::FillRect:
+          push(Op{to_px(cmd.rect.x), to_px(cmd.rect.y), to_px(cmd.rect.x + cmd.rect.w),
+                  to_px(cmd.rect.y + cmd.rect.h), px, (px >> 24) != 0xFF});
+          break;
+        case ui::DrawCommand::DrawText: {
+          const ui::Point p{cmd.rect.x, cmd.rect.y};
+          const raster::GlyphRun& run = raster::shape(list.text().view(cmd.text), cmd.font, text_cache);
+          if (run.glyphs.empty()) break;
+          Op op{0, 0, 0, 0, px, (px >> 24) != 0xFF, (std::uint32_t)glyphs.size(), (std::uint32_t)run.glyphs.size()};
+          for (float gx : run.glyphs) {
+            const raster::GlyphBox b = raster::glyph_box(p, gx, cmd.font);
+            if (glyphs.size() == op.glyph_first) { op.x0 = b.x0; op.y0 = b.y0; op.x1 = b.x1; op.y1 = b.y1; }
+            op.x0 = std::min(op.x0, b.x0); op.y0 = std::min(op.y0, b.y0);
+            op.x1 = std::max(op.x1, b.x1); op.y1 = std::max(op.y1, b.y1);
+            glyphs.push_back(b);
+          }
+          push(op);
+          break;
+        }
+        case ui::DrawCommand::DrawImage: {
+          const ui::Image& img = list.image(cmd.image);
+          if (!img || cmd.rect.w <= 0 || cmd.rect.h <= 0) break;
+          ui::SurfaceCache::SurfacePtr s = surface_cache.get(img, cmd.rect, dpi_scale);
+          raster::ImageBlit b;
+          if (!s || !raster::image_blit(cmd.rect, *s, cmd.color.a, b)) break;
+          Op op{b.x0, b.y0, b.x1, b.y1, 0, true};
+          op.blit = (std::uint32_t)blits.size();
+          blits.push_back(b);
+          surfaces.push_back(std::move(s));
+          push(op);
+          break;
+        }
+      }
+    }
+
+    work.clear();
+    for (std::uint32_t t = 0; t < bins.size(); ++t) {
+      if (!bins[t].empty()) work.push_back(t);
+    }
+  }
+
+  void render(const ui::DisplayList& list, Framebuffer& target) {
+    fb = &target;
+    bin(list);
+    ++stats.frames;
+    stats.tiles += work.size();
+    if (work.empty()) return;
+
+    // Contiguous slices keep neighbouring tiles (and their rows) on one thread.
+    const auto n = (std::uint32_t)work.size();
+    for (unsigned id = 0; id < nthreads; ++id) {
+      ranges[id].reset((std::uint32_t)((std::uint64_t)n * id / nthreads),
+                       (std::uint32_t)((std::uint64_t)n * (id + 1) / nthreads));
+    }
+    stolen.store(0, std::memory_order_relaxed);
+
+    if (nthreads > 1) {
+      std::lock_guard<std::mutex> lock(mx);
+      running = nthreads - 1;
+      ++generation;
+    }
+    start_cv.notify_all();
+    run(0);
+    if (nthreads > 1) {
+      std::unique_lock<std::mutex> lock(mx);
+      done_cv.wait(lock, [&] { return running == 0; });
+    }
+    stats.stolen += stolen.load(std::memory_order_relaxed);
+    surfaces.clear();
+  }
+};
+
+TileRasterizer::TileRasterizer(unsigned threads, int tile) : impl_(std::make_unique<Impl>(threads, tile)) {}
+TileRasterizer::~TileRasterizer() = default;
+
+void TileRasterizer::render(const ui::DisplayList& list, Framebuffer& fb) { impl_->render(list, fb); }
+
+void TileRasterizer::set_dpi_scale(float s) { impl_->dpi_scale = s > 0 ? s : 1.f; }
+unsigned TileRasterizer::threads() const { return impl_->nthreads; }
+int TileRasterizer::tile_size() const { return impl_->tile; }
+const TileStats& TileRasterizer::stats() const { return impl_->stats; }
+
+} // namespace pulseui::platform
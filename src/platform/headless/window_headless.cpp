@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <pulseui/core/profiler.hpp>
+#include <pulseui/platform/headless.hpp>
+#include "run_loop.hpp"
+
+namespace pulseui::platform {
+
+HeadlessWindow::HeadlessWindow(int width, int height, std::string title)
+  : title_(std::move(title)) {
+  fb_.resize(width, height);
+  RunLoop::instance().add_window(this);
+}
+
+HeadlessWindow::~HeadlessWindow() {
+  RunLoop::instance().remove_window(this);
+}
+
+void HeadlessWindow::on_paint(PaintCB cb) {
+  paint_cb_ = std::move(cb);
+  invalidate();
+}
+
+void HeadlessWindow::invalidate() {
+  {
+    std::lock_guard<std::mutex> lock(damage_mx_);
+    full_damage_ = true;
+    damage_.clear();
+  }
+  mark_dirty();
+}
+
+void HeadlessWindow::invalidate(ui::Rect r) {
+  {
+    std::lock_guard<std::mutex> lock(damage_mx_);
+    if (full_damage_) return;
+    damage_.add(ui::intersect(r, ui::Rect{0, 0, (float)fb_.width, (float)fb_.height}));
+    if (damage_.empty()) return;
+  }
+  mark_dirty();
+}
+
+void HeadlessWindow::scroll(ui::Rect area, float dx, float dy) {
+  const int ix = (int)std::lround(dx), iy = (int)std::lround(dy);
+  const int x0 = std::max(0, (int)std::floor(area.x)), y0 = std::max(0, (int)std::floor(area.y));
+  const int x1 = std::min(fb_.width, (int)std::ceil(area.x + area.w));
+  const int y1 = std::min(fb_.height, (int)std::ceil(area.y + area.h));
+  if ((float)ix != dx || (float)iy != dy || std::abs(ix) >= x1 - x0 || std::abs(iy) >= y1 - y0) {
+    invalidate(area);
+    return;
+  }
+  if (ix == 0 && iy == 0) return;
+  const ui::Rect px{(float)x0, (float)y0, (float)(x1 - x0), (float)(y1 - y0)};
+
+  {
+    std::lock_guard<std::mutex> lock(damage_mx_);
+    if (!full_damage_) {
+      // Damage not painted yet moves with the content (and stays where it was).
+      ui::Region moved;
+      for (const ui::Rect& r : damage_.rects()) {
+        moved.add(ui::intersect(ui::translate(ui::intersect(r, px), dx, dy), px));
+      }
+      damage_.add(moved);
+      ui::scroll_exposed(px, dx, dy, [&](const ui::Rect& r) { damage_.add(r); });
+    }
+  }
+
+  // Rows are copied in the direction that does not overwrite unread source rows.
+  const int dst_x = x0 + std::max(ix, 0);
+  const auto n = (std::size_t)(x1 - x0 - std::abs(ix));
+  auto copy_row = [&](int y) {
+    std::memmove(fb_.row(y) + dst_x, fb_.row(y - iy) + dst_x - ix, n * sizeof(std::uint32_t));
+  };
+  if (iy > 0) {
+    for (int y = y1 - 1; y >= y0 + iy; --y) copy_row(y);
+  } else {
+    for (int y = y0; y < y1 + iy; ++y) copy_row(y);
+  }
+  mark_dirty();
+}
+
+void HeadlessWindow::mark_dirty() {
+  if (!dirty_.exchange(true, std::memory_order_acq_rel)) RunLoop::instance().wake();
+}
+
+void HeadlessWindow::paint() {
+  invalidate();
+  paint_if_needed();
+}
+
+bool HeadlessWindow::paint_if_needed() {
+  if (!dirty_.exchange(false, std::memory_order_acq_rel)) return false;
+
+  bool full;
+  {
+    std::lock_guard<std::mutex> lock(damage_mx_);
+    full = full_damage_;
+    std::swap(paint_damage_, damage_);
+    damage_.clear();
+    full_damage_ = false;
+  }
+
+  ++frames_;
+  if (!paint_cb_) return true;
+  PULSEUI_PROFILE_SCOPE("paint");
+  RasterCanvas canvas(fb_);
+  canvas.set_dpi_scale(dpi_scale_);
+  if (!full) canvas.set_damage(&paint_damage_);
+  paint_cb_(canvas);
+  ui::paint_arena().reset();
+  return true;
+}
+
+void HeadlessWindow::send_input(ui::InputEvent e) {
+  if (e.timestamp == 0) e.timestamp = ui::input_timestamp();
+  if (input_cb_) input_cb_(e);
+  if (input_batch_cb_) input_queue_.push(e);
+}
+
+bool HeadlessWindow::flush_input() {
+  PULSEUI_PROFILE_SCOPE("input");
+  return input_queue_.flush([&](std::span<const ui::InputEvent> batch) {
+    if (input_batch_cb_) input_batch_cb_(batch);
+  });
+}
+
+void HeadlessWindow::resize(int width, int height) {
+  fb_.resize(width, height);
+  invalidate();
+}
+
+std::unique_ptr<HeadlessWindow> make_headless_window(int width, int height, const std::string& title) {
+  return std::make_unique<HeadlessWindow>(width, height, title);
+}
+
+} // namespace pulseui::platform
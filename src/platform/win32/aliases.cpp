@@ -1,4 +1,5 @@
 #include <pulseui/platform/platform.hpp>
+#include "canvas_gdi.hpp"
 #include <memory>
 #include <string>
 
@@ -12,4 +13,6 @@ std::unique_ptr<ui::Window>     make_window(int w, int h, const std::string& tit
   return make_win32_window(w, h, title);
 }
 
+ui::TextCacheStats text_cache_stats() { return gdi_text_cache().stats(); }
+
 } // namespace pulseui::platform
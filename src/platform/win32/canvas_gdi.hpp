@@ -1,10 +1,17 @@
 #pragma once
 
 #include <windows.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <cmath>
 #include <pulseui/ui/canvas.hpp>
+#include <pulseui/ui/image_cache.hpp>
+#include <pulseui/ui/region.hpp>
+#include <pulseui/ui/text_cache.hpp>
 
 namespace pulseui::platform {
 
@@ -33,16 +40,116 @@ inline COLORREF to_colorref(ui::Color c) {
   return RGB(R, G, B);
 }
 
+// UTF-16 text with its extents in the default GUI font.
+struct GdiTextRun {
+  std::wstring text;
+  ui::TextMetrics metrics;
+  std::size_t bytes() const { return text.capacity() * sizeof(wchar_t); }
+};
+
+// Premultiplied BGRA DIB section of a ui::Surface, as AlphaBlend wants it.
+// Kept in Surface::native, so it lives as long as the cached surface.
+struct GdiBitmap {
+  HBITMAP handle{nullptr};
+  ~GdiBitmap() { if (handle) DeleteObject(handle); }
+
+  static std::shared_ptr<GdiBitmap> make(const ui::Surface& s) {
+    BITMAPINFO bi{};
+    bi.bmiHeader.biSize        = sizeof(BITMAPINFOHEADER);
+    bi.bmiHeader.biWidth       = s.width;
+    bi.bmiHeader.biHeight      = -s.height; // top-down
+    bi.bmiHeader.biPlanes      = 1;
+    bi.bmiHeader.biBitCount    = 32;
+    bi.bmiHeader.biCompression = BI_RGB;
+    void* bits = nullptr;
+    auto bmp = std::make_shared<GdiBitmap>();
+    bmp->handle = CreateDIBSection(nullptr, &bi, DIB_RGB_COLORS, &bits, nullptr, 0);
+    if (!bmp->handle || !bits) return nullptr;
+    auto* out = static_cast<std::uint32_t*>(bits);
+    for (int y = 0; y < s.height; ++y) {
+      const std::uint32_t* row = s.row(y);
+      for (int x = 0; x < s.width; ++x) {
+        const std::uint32_t p = row[x], a = p >> 24;
+        const std::uint32_t r = (p & 0xFF) * a / 255, g = ((p >> 8) & 0xFF) * a / 255, b = ((p >> 16) & 0xFF) * a / 255;
+        *out++ = b | (g << 8) | (r << 16) | (a << 24);
+      }
+    }
+    return bmp;
+  }
+};
+
+// Small LRU set of solid brushes, so fills stop creating and deleting a brush
+// per rect.
+class GdiBrushCache {
+public:
+  GdiBrushCache() = default;
+  GdiBrushCache(const GdiBrushCache&) = delete;
+  GdiBrushCache& operator=(const GdiBrushCache&) = delete;
+  ~GdiBrushCache() {
+    for (Slot& s : slots_) if (s.brush) DeleteObject(s.brush);
+  }
+
+  HBRUSH get(COLORREF color) {
+    ++tick_;
+    Slot* victim = &slots_[0];
+    for (Slot& s : slots_) {
+      if (s.brush && s.color == color) {
+        s.used = tick_;
+        return s.brush;
+      }
+      if (s.used < victim->used) victim = &s;
+    }
+    if (victim->brush) DeleteObject(victim->brush);
+    *victim = Slot{color, CreateSolidBrush(color), tick_};
+    return victim->brush;
+  }
+
+private:
+  struct Slot {
+    COLORREF color{};
+    HBRUSH brush{nullptr};
+    std::uint64_t used{0};
+  };
+  std::array<Slot, 32> slots_{};
+  std::uint64_t tick_{0};
+};
+
+// Shared by all GdiCanvas instances of the UI thread.
+inline GdiBrushCache& gdi_brush_cache() {
+  static GdiBrushCache cache;
+  return cache;
+}
+
+// Shared by all GdiCanvas instances of the UI thread.
+inline ui::TextCache<GdiTextRun>& gdi_text_cache() {
+  static ui::TextCache<GdiTextRun> cache;
+  return cache;
+}
+
 class GdiCanvas : public ui::Canvas {
 public:
   explicit GdiCanvas(HDC hdc) : hdc_(hdc) {}
 
+  // Text state is set up on first use and kept for the canvas' lifetime.
+  ~GdiCanvas() override {
+    if (image_dc_) DeleteDC(image_dc_);
+    if (!old_font_) return;
+    SetTextColor(hdc_, old_text_color_);
+    SetBkMode(hdc_, old_bk_mode_);
+    SelectObject(hdc_, old_font_);
+  }
+
+  GdiCanvas(const GdiCanvas&) = delete;
+  GdiCanvas& operator=(const GdiCanvas&) = delete;
+
+  // The HDC is addressed in device pixels, whatever the monitor's DPI
+  // (Window::dpi_scale reports that for layout).
+  float dpi_scale() const override { return 1.f; }
+
   void clear(ui::Color c) override {
     RECT rc{};
     GetClipBox(hdc_, &rc);
-    HBRUSH br = CreateSolidBrush(to_colorref(c));
-    FillRect(hdc_, &rc, br);
-    DeleteObject(br);
+    FillRect(hdc_, &rc, gdi_brush_cache().get(to_colorref(c)));
   }
 
   void fill_rect(ui::Rect r, ui::Color c) override {
@@ -52,33 +159,83 @@ public:
       to_LONG(r.x + r.w),
       to_LONG(r.y + r.h)
     };
-    HBRUSH br = CreateSolidBrush(to_colorref(c));
-    FillRect(hdc_, &rc, br);
-    DeleteObject(br);
+    FillRect(hdc_, &rc, gdi_brush_cache().get(to_colorref(c)));
   }
 
   void draw_text(ui::Point p,
                  std::string_view utf8,
-                 const ui::Font& /*font*/,
+                 const ui::Font& font,
                  ui::Color color) override {
-    HFONT oldFont = (HFONT)SelectObject(hdc_, GetStockObject(DEFAULT_GUI_FONT));
-    int    oldBk  = SetBkMode(hdc_, TRANSPARENT);
-    COLORREF oldTx = SetTextColor(hdc_, to_colorref(color));
-
-    std::wstring w = widen_utf8(utf8);
-    if (!w.empty()) {
-      TextOutW(hdc_, to_LONG(p.x), to_LONG(p.y), w.c_str(), (int)w.size());
+    const GdiTextRun& run = text_run(utf8, font);
+    if (run.text.empty()) return;
+    const COLORREF cr = to_colorref(color);
+    if (cr != text_color_) {
+      SetTextColor(hdc_, cr);
+      text_color_ = cr;
     }
+    TextOutW(hdc_, to_LONG(p.x), to_LONG(p.y), run.text.c_str(), (int)run.text.size());
+  }
 
-    SetTextColor(hdc_, oldTx);
-    SetBkMode(hdc_, oldBk);
-    SelectObject(hdc_, oldFont);
+  // GDI coordinates are device pixels, so the mip level follows dst directly.
+  void draw_image(ui::Rect dst, const ui::Image& img, float opacity) override {
+    if (!img || dst.w <= 0 || dst.h <= 0) return;
+    const ui::SurfaceCache::SurfacePtr s = ui::surface_cache().get(img, dst, 1.f);
+    if (!s) return;
+    if (!s->native) s->native = GdiBitmap::make(*s);
+    auto* bmp = static_cast<GdiBitmap*>(s->native.get());
+    if (!bmp) return;
+    if (!image_dc_) image_dc_ = CreateCompatibleDC(hdc_);
+    const HGDIOBJ old = SelectObject(image_dc_, bmp->handle);
+    const BLENDFUNCTION blend{AC_SRC_OVER, 0, (BYTE)(std::clamp(opacity, 0.f, 1.f) * 255.f + 0.5f), AC_SRC_ALPHA};
+    AlphaBlend(hdc_, to_LONG(dst.x), to_LONG(dst.y), to_LONG(dst.x + dst.w) - to_LONG(dst.x),
+               to_LONG(dst.y + dst.h) - to_LONG(dst.y), image_dc_, 0, 0, s->width, s->height, blend);
+    SelectObject(image_dc_, old);
   }
 
+  ui::TextMetrics measure_text(std::string_view utf8, const ui::Font& font) override {
+    return text_run(utf8, font).metrics;
+  }
+
+  // GDI already clips to the update region; this only exposes it to widgets.
+  const ui::Region* damage() const override { return damage_; }
+  void set_damage(const ui::Region* d) { damage_ = d; }
+
   HDC hdc() const { return hdc_; }
 
 private:
+  void select_text_state() {
+    if (old_font_) return;
+    old_font_       = (HFONT)SelectObject(hdc_, GetStockObject(DEFAULT_GUI_FONT));
+    old_bk_mode_    = SetBkMode(hdc_, TRANSPARENT);
+    old_text_color_ = GetTextColor(hdc_);
+    text_color_     = old_text_color_;
+    TEXTMETRICW tm{};
+    GetTextMetricsW(hdc_, &tm);
+    ascent_  = (float)tm.tmAscent;
+    descent_ = (float)tm.tmDescent;
+  }
+
+  const GdiTextRun& text_run(std::string_view utf8, const ui::Font& font) {
+    select_text_state();
+    return gdi_text_cache().get(utf8, font, 1.f, [&](std::string_view t) {
+      GdiTextRun run{widen_utf8(t), {}};
+      SIZE sz{};
+      if (!run.text.empty()) GetTextExtentPoint32W(hdc_, run.text.c_str(), (int)run.text.size(), &sz);
+      run.metrics = ui::TextMetrics{(float)sz.cx, ascent_, descent_};
+      return run;
+    });
+  }
+
   HDC hdc_{nullptr};
+  HDC image_dc_{nullptr}; // memory DC for AlphaBlend sources, made on first image
+  const ui::Region* damage_{nullptr};
+
+  HFONT    old_font_{nullptr};
+  int      old_bk_mode_{0};
+  COLORREF old_text_color_{0};
+  COLORREF text_color_{0};
+  float    ascent_{0.f};
+  float    descent_{0.f};
 };
 
 } // namespace pulseui::platform
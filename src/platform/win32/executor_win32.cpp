@@ -1,27 +1,28 @@
 #include <windows.h>
-#include <functional>
-#include <queue>
-#include <mutex>
 #include <memory>
 
 #include <pulseui/core/executor.hpp>
+#include <pulseui/core/mpsc_queue.hpp>
+#include <pulseui/core/task.hpp>
 
 namespace pulseui::platform {
 
 class UiExecutor final : public core::executor {
 public:
-  using Fn = std::function<void()>;
-
   UiExecutor() { create_message_window(); }
-  ~UiExecutor() override { if (hwnd_) DestroyWindow(hwnd_); }
+  ~UiExecutor() override {
+    if (hwnd_) DestroyWindow(hwnd_);
+    queue_.begin_drain();
+    while (core::task_node* n = queue_.pop()) delete n;
+  }
 
   // === core::executor override ===
-  void post(std::function<void()> fn) override {
-    {
-      std::lock_guard<std::mutex> lock(mx_);
-      queue_.push(std::move(fn));
+  using core::executor::post;
+  void post(core::task t) override {
+    // Pooled node, lock-free push; only the idle->busy transition costs a window message.
+    if (queue_.push(new core::task_node(std::move(t)))) {
+      PostMessageW(hwnd_, WM_APP_EXECUTE, 0, 0);
     }
-    PostMessageW(hwnd_, WM_APP_EXECUTE, 0, 0);
   }
 
   HWND hwnd() const { return hwnd_; }
@@ -41,15 +42,10 @@ private:
     }
 
     if (msg == WM_APP_EXECUTE && self) {
-      std::queue<Fn> local;
-      {
-        std::lock_guard<std::mutex> lock(self->mx_);
-        std::swap(local, self->queue_);
-      }
-      while (!local.empty()) {
-        auto fn = std::move(local.front());
-        local.pop();
-        if (fn) fn();
+      self->queue_.begin_drain();
+      while (core::task_node* n = self->queue_.pop()) {
+        std::unique_ptr<core::task_node> task(n);
+        task->run();
       }
       return 0;
     }
@@ -71,8 +67,7 @@ private:
 
 private:
   HWND hwnd_{nullptr};
-  std::mutex mx_;
-  std::queue<Fn> queue_;
+  core::mpsc_queue<core::task_node> queue_;
 };
 
 std::unique_ptr<core::executor> make_win32_executor() {
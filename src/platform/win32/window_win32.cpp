@@ -5,10 +5,15 @@
 #include <functional>
 #include <memory>
 #include <utility>
+#include <vector>
+#include <cmath>
 
+#include <pulseui/core/profiler.hpp>
 #include <pulseui/ui/window.hpp>
 #include <pulseui/ui/canvas.hpp>
 #include <pulseui/ui/input.hpp>
+#include <pulseui/ui/input_queue.hpp>
+#include <pulseui/ui/region.hpp>
 #include "canvas_gdi.hpp"
 
 namespace pulseui::platform {
@@ -35,6 +40,44 @@ public:
     InvalidateRect(hwnd_, nullptr, FALSE);
   }
 
+  void invalidate(ui::Rect r) override {
+    if (!hwnd_ || ui::empty(r)) return;
+    RECT rc{
+      (LONG)std::floor(r.x),
+      (LONG)std::floor(r.y),
+      (LONG)std::ceil(r.x + r.w),
+      (LONG)std::ceil(r.y + r.h)
+    };
+    // The system accumulates the update region; WM_PAINT reads it back.
+    InvalidateRect(hwnd_, &rc, FALSE);
+  }
+
+  void scroll(ui::Rect area, float dx, float dy) override {
+    if (!hwnd_ || ui::empty(area)) return;
+    const int ix = (int)std::lround(dx), iy = (int)std::lround(dy);
+    if ((float)ix != dx || (float)iy != dy) { invalidate(area); return; }
+    RECT rc{
+      (LONG)std::floor(area.x),
+      (LONG)std::floor(area.y),
+      (LONG)std::ceil(area.x + area.w),
+      (LONG)std::ceil(area.y + area.h)
+    };
+    // ScrollWindowEx moves pixels only; the pending update region inside rc
+    // has to move along, or it would be painted at its old place.
+    HRGN pending = CreateRectRgn(0, 0, 0, 0);
+    const bool has_pending = GetUpdateRgn(hwnd_, pending, FALSE) > NULLREGION;
+    ScrollWindowEx(hwnd_, ix, iy, &rc, &rc, nullptr, nullptr, SW_INVALIDATE);
+    if (has_pending) {
+      HRGN clip = CreateRectRgnIndirect(&rc);
+      CombineRgn(pending, pending, clip, RGN_AND);
+      OffsetRgn(pending, ix, iy);
+      CombineRgn(pending, pending, clip, RGN_AND);
+      InvalidateRgn(hwnd_, pending, FALSE);
+      DeleteObject(clip);
+    }
+    DeleteObject(pending);
+  }
+
   float dpi_scale() const override {
     if (!hwnd_) {
       HDC screen = GetDC(nullptr);
@@ -57,6 +100,18 @@ public:
     input_cb_ = std::move(cb);
   }
 
+  void on_input_batch(InputBatchCB cb) override {
+    input_batch_cb_ = std::move(cb);
+  }
+
+  void set_keep_move_history(bool on) override {
+    input_queue_.set_keep_move_history(on);
+  }
+
+  std::span<const ui::InputEvent> move_history() const override {
+    return input_queue_.delivered_move_history();
+  }
+
   void set_size(int width, int height) {
     if (!hwnd_) return;
     SetWindowPos(hwnd_, nullptr, 0, 0, width, height,
@@ -70,6 +125,7 @@ public:
 
 private:
   static const wchar_t* kClassName() { return L"PulseUIWindow"; }
+  static constexpr UINT_PTR kInputFlushTimer = 1;
 
   static LRESULT CALLBACK WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam) {
     Win32Window* self = nullptr;
@@ -84,12 +140,16 @@ private:
 
     switch (msg) {
       case WM_PAINT: {
+        PULSEUI_PROFILE_SCOPE("paint");
+        const bool partial = self && self->read_update_region();
         PAINTSTRUCT ps;
         HDC hdc = BeginPaint(hWnd, &ps);
         if (self && self->paint_cb_) {
           pulseui::platform::GdiCanvas gdi(hdc);
+          if (partial) gdi.set_damage(&self->paint_damage_);
           ui::Canvas& canvas = gdi;
           self->paint_cb_(canvas);
+          ui::paint_arena().reset();
         }
         EndPaint(hWnd, &ps);
         return 0;
@@ -106,8 +166,9 @@ private:
       case WM_KEYDOWN:
       case WM_KEYUP:
       {
-        if (self && self->input_cb_) {
+        if (self && (self->input_cb_ || self->input_batch_cb_)) {
           ui::InputEvent ev{};
+          ev.timestamp = ui::input_timestamp();
 
           POINT pt{};
           if (msg == WM_MOUSEWHEEL) {
@@ -141,11 +202,20 @@ private:
             default:             ev.type = ui::InputEvent::MouseMove; ev.keycode = 0; break;
           }
 
-          self->input_cb_(ev);
+          if (self->input_cb_) self->input_cb_(ev);
+          if (self->input_batch_cb_) self->queue_input(ev);
         }
         break;
       }
 
+      case WM_TIMER:
+        if (self && wParam == kInputFlushTimer) {
+          KillTimer(hWnd, kInputFlushTimer);
+          self->flush_input();
+          return 0;
+        }
+        break;
+
       case WM_DESTROY:
         PostQuitMessage(0);
         return 0;
@@ -156,6 +226,48 @@ private:
     return DefWindowProcW(hWnd, msg, wParam, lParam);
   }
 
+  // WM_TIMER is only generated once the message queue is otherwise empty, so
+  // the batch collects everything that arrived in one burst.
+  void queue_input(const ui::InputEvent& ev) {
+    const bool was_empty = input_queue_.empty();
+    input_queue_.push(ev);
+    if (was_empty) SetTimer(hwnd_, kInputFlushTimer, USER_TIMER_MINIMUM, nullptr);
+  }
+
+  void flush_input() {
+    PULSEUI_PROFILE_SCOPE("input");
+    input_queue_.flush([&](std::span<const ui::InputEvent> batch) {
+      if (input_batch_cb_) input_batch_cb_(batch);
+    });
+  }
+
+  // Copies the pending update region into paint_damage_. Returns false when
+  // the whole client area is being repainted.
+  bool read_update_region() {
+    paint_damage_.clear();
+    HRGN rgn = CreateRectRgn(0, 0, 0, 0);
+    const int kind = GetUpdateRgn(hwnd_, rgn, FALSE);
+    if (kind == SIMPLEREGION || kind == COMPLEXREGION) {
+      const DWORD bytes = GetRegionData(rgn, 0, nullptr);
+      region_buf_.resize(bytes);
+      auto* data = reinterpret_cast<RGNDATA*>(region_buf_.data());
+      if (bytes && GetRegionData(rgn, bytes, data)) {
+        const RECT* rc = reinterpret_cast<const RECT*>(data->Buffer);
+        for (DWORD i = 0; i < data->rdh.nCount; ++i) {
+          paint_damage_.add(ui::Rect{(float)rc[i].left, (float)rc[i].top,
+                                     (float)(rc[i].right - rc[i].left),
+                                     (float)(rc[i].bottom - rc[i].top)});
+        }
+      }
+    }
+    DeleteObject(rgn);
+
+    RECT client{};
+    GetClientRect(hwnd_, &client);
+    const ui::Rect full{0, 0, (float)client.right, (float)client.bottom};
+    return !paint_damage_.empty() && !ui::contains(paint_damage_.bounds(), full);
+  }
+
   static void register_class() {
     static bool registered = false;
     if (registered) return;
@@ -194,6 +306,10 @@ private:
   HWND hwnd_{nullptr};
   ui::Window::PaintCB paint_cb_{};
   ui::Window::InputCB input_cb_{};
+  ui::Window::InputBatchCB input_batch_cb_{};
+  ui::InputQueue input_queue_;
+  ui::Region paint_damage_;
+  std::vector<char> region_buf_;
 };
 
 std::unique_ptr<ui::Window> make_win32_window(int width, int height, const std::string& title_utf8) {
@@ -0,0 +1,16 @@
+#include <pulseui/platform/headless.hpp>
+#include "../platform/headless/run_loop.hpp"
+
+namespace pulseui::platform {
+
+void app_init() {
+
+}
+
+// There is no OS event source: the run loop sleeps on its task queue, which
+// posts and window invalidations wake.
+void app_run() { RunLoop::instance().run(); }
+
+void app_quit() { RunLoop::instance().quit(); }
+
+} // namespace pulseui::platform
@@ -21,4 +21,8 @@ void app_run() {
   }
 }
 
+void app_quit() {
+  PostQuitMessage(0);
+}
+
 } // namespace pulseui::platform